@@ -0,0 +1,404 @@
+#ifndef CONCURRENTINDEXLIST_H
+#define CONCURRENTINDEXLIST_H
+
+#include "indexlist.h"
+
+#include <atomic>
+#include <array>
+
+// Pool of ConcurrentIndexList. Slots live in chunks that are allocated on
+// demand and never move, so any thread can acquire or release a slot while
+// others keep using theirs. Free slots form a lock-free stack, its head packs
+// the top slot with a tag that changes on every push and pop against ABA.
+// Released slots are marked like erased IndexList slots, by a link pointing
+// back to themselves. A Magazine caches free slots for one thread and moves
+// them from and to the shared stack in batches.
+template<class T, class Index = uint32_t, size_t ChunkSize = 1024, size_t MaxChunks = 4096>
+class IndexConcurrentPool{
+    static_assert(ChunkSize > 0 && (ChunkSize & (ChunkSize - 1)) == 0, "ChunkSize has to be a power of two");
+    static_assert(sizeof(Index) <= sizeof(uint32_t), "the free stack head packs a slot and a 32 bit tag into 64 bits");
+
+    public:
+
+    constexpr static Index noSlot       = std::numeric_limits<Index>::max();
+    constexpr static size_t maxSlots    = std::min<size_t>(ChunkSize * MaxChunks, noSlot);
+    constexpr static size_t batchSize   = 32;
+
+    // free slots owned by one thread, refilled with batchSize slots when
+    // empty and drained by batchSize slots when full. Gives its slots back
+    // on destruction, so it must not outlive the pool.
+    class Magazine{
+        public:
+        explicit Magazine(IndexConcurrentPool& pool) : _pool(&pool){}
+        Magazine(const Magazine&) = delete;
+        Magazine& operator = (const Magazine&) = delete;
+        ~Magazine(){
+            if(_count){
+                _pool->pushBatch(_slots, _count);
+            }
+        }
+
+        private:
+        IndexConcurrentPool*    _pool;
+        Index                   _slots[2 * batchSize];
+        size_t                  _count = 0;
+
+        friend IndexConcurrentPool;
+    };
+
+    IndexConcurrentPool(){
+        // slot 0 is the list sentinel and never on the free stack
+        ensureChunk(0);
+        _size.store(1, std::memory_order_relaxed);
+    }
+    IndexConcurrentPool(const IndexConcurrentPool&) = delete;
+    IndexConcurrentPool& operator = (const IndexConcurrentPool&) = delete;
+    ~IndexConcurrentPool(){
+        const size_t size = _size.load(std::memory_order_acquire);
+        if constexpr(!std::is_trivially_destructible_v<T>){
+            for(size_t index = 1; index < size; ++index){
+                if(hasData(static_cast<Index>(index))){
+                    node(index).getData().~T();
+                }
+            }
+        }
+        for(auto& chunk : _chunks){
+            Node* nodes = chunk.load(std::memory_order_relaxed);
+            if(nodes){
+                destroyChunk(nodes);
+            }
+        }
+    }
+
+    IndexLink<Index>& link(Index index){return node(index);}
+    const IndexLink<Index>& link(Index index) const {return node(index);}
+    T& data(Index index){return node(index).getData();}
+    const T& data(Index index) const {return node(index).getData();}
+    bool hasData(Index index) const {return (index != 0 && link(index).getPrevious() != index);}
+
+    // thread safe, constructs a payload in a free slot and returns the slot
+    // unlinked
+    template <class... Args>
+    Index acquire(Args&&... args){
+        Index index = pop();
+        if(index == noSlot){
+            grow(&index, 1);
+        }
+        try{
+            construct(index, std::forward<Args>(args)...);
+        }
+        catch(...){
+            push(index);
+            throw;
+        }
+        return index;
+    }
+
+    // acquire() served from the magazine of the calling thread, only an
+    // empty magazine touches the shared stack
+    template <class... Args>
+    Index acquire(Magazine& magazine, Args&&... args){
+        if(magazine._count == 0){
+            magazine._count = popBatch(magazine._slots, batchSize);
+        }
+        const Index index = magazine._slots[--magazine._count];
+        try{
+            construct(index, std::forward<Args>(args)...);
+        }
+        catch(...){
+            magazine._count++;
+            throw;
+        }
+        return index;
+    }
+
+    // thread safe, destroys the payload of an unlinked slot and frees it
+    void release(Index index){
+        destroy(index);
+        push(index);
+    }
+
+    // release() into the magazine of the calling thread, only a full
+    // magazine touches the shared stack
+    void release(Magazine& magazine, Index index){
+        destroy(index);
+        if(magazine._count == 2 * batchSize){
+            pushBatch(magazine._slots + batchSize, batchSize);
+            magazine._count = batchSize;
+        }
+        magazine._slots[magazine._count++] = index;
+    }
+
+    // slots handed out so far, sentinel included
+    size_t size() const {return _size.load(std::memory_order_relaxed);}
+    size_t capacity() const {return maxSlots;}
+
+    private:
+
+    struct Node : public IndexNode<T, Index>{
+        std::atomic<Index> nextFree{noSlot};
+    };
+
+    constexpr static size_t chunkMask = ChunkSize - 1;
+
+    std::array<std::atomic<Node*>, MaxChunks>   _chunks{};
+    std::atomic<size_t>                         _size{0};
+    std::atomic<uint64_t>                       _freeHead{pack(noSlot, 0)};
+
+    constexpr static uint64_t pack(Index index, uint32_t tag){
+        return (static_cast<uint64_t>(tag) << 32) | static_cast<uint64_t>(index);
+    }
+    constexpr static Index headSlot(uint64_t head){
+        return static_cast<Index>(head & 0xffffffffu);
+    }
+    constexpr static uint32_t headTag(uint64_t head){
+        return static_cast<uint32_t>(head >> 32);
+    }
+
+    Node& node(size_t index) const{
+        return _chunks[index / ChunkSize].load(std::memory_order_acquire)[index & chunkMask];
+    }
+
+    template <class... Args>
+    void construct(Index index, Args&&... args){
+        Node& target = node(index);
+        new (&target.getData()) T(std::forward<Args>(args)...);
+        target.setPrevious(0);
+        target.setNext(0);
+    }
+
+    void destroy(Index index){
+        Node& target = node(index);
+        if constexpr(!std::is_trivially_destructible_v<T>){
+            target.getData().~T();
+        }
+        target.setPrevious(index);
+    }
+
+    Index pop(){
+        uint64_t head = _freeHead.load(std::memory_order_acquire);
+        while(headSlot(head) != noSlot){
+            const Index index   = headSlot(head);
+            const Index next    = node(index).nextFree.load(std::memory_order_relaxed);
+            if(_freeHead.compare_exchange_weak(head, pack(next, headTag(head) + 1), std::memory_order_acquire, std::memory_order_acquire)){
+                return index;
+            }
+        }
+        return noSlot;
+    }
+
+    void push(Index index){
+        pushBatch(&index, 1);
+    }
+
+    // pushes the slots as one chain with a single exchange of the head
+    void pushBatch(const Index* slots, size_t count){
+        for(size_t slot = 0; slot + 1 < count; ++slot){
+            node(slots[slot]).nextFree.store(slots[slot + 1], std::memory_order_relaxed);
+        }
+        Node& last      = node(slots[count - 1]);
+        uint64_t head   = _freeHead.load(std::memory_order_relaxed);
+        do{
+            last.nextFree.store(headSlot(head), std::memory_order_relaxed);
+        }while(!_freeHead.compare_exchange_weak(head, pack(slots[0], headTag(head) + 1), std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    // pops up to count slots with a single exchange of the head, the chain
+    // read on the way is only trusted if the tagged head did not change.
+    // Falls back to fresh slots when the stack is empty.
+    size_t popBatch(Index* slots, size_t count){
+        uint64_t head = _freeHead.load(std::memory_order_acquire);
+        while(headSlot(head) != noSlot){
+            size_t taken    = 0;
+            Index index     = headSlot(head);
+            while(index != noSlot && taken < count){
+                slots[taken++]  = index;
+                index           = node(index).nextFree.load(std::memory_order_relaxed);
+            }
+            if(_freeHead.compare_exchange_weak(head, pack(index, headTag(head) + 1), std::memory_order_acquire, std::memory_order_acquire)){
+                return taken;
+            }
+        }
+        return grow(slots, count);
+    }
+
+    // claims up to count never used slots, allocating their chunks if
+    // needed. They are stored highest first so a magazine hands them out in
+    // ascending order.
+    size_t grow(Index* slots, size_t count){
+        size_t fresh = _size.load(std::memory_order_relaxed);
+        size_t claimed;
+        do{
+            if(fresh >= maxSlots){
+                throw std::length_error("ConcurrentIndexList: pool is full");
+            }
+            claimed = std::min(count, maxSlots - fresh);
+        }while(!_size.compare_exchange_weak(fresh, fresh + claimed, std::memory_order_relaxed));
+
+        for(size_t chunk = fresh / ChunkSize; chunk <= (fresh + claimed - 1) / ChunkSize; ++chunk){
+            ensureChunk(chunk);
+        }
+        for(size_t slot = 0; slot < claimed; ++slot){
+            slots[slot] = static_cast<Index>(fresh + claimed - 1 - slot);
+        }
+        return claimed;
+    }
+
+    void ensureChunk(size_t chunk){
+        if(_chunks[chunk].load(std::memory_order_acquire) != nullptr){
+            return;
+        }
+        Node* nodes = std::allocator<Node>().allocate(ChunkSize);
+        for(size_t index = 0; index < ChunkSize; ++index){
+            new (&nodes[index]) Node();
+            nodes[index].setPrevious(static_cast<Index>(chunk * ChunkSize + index));
+        }
+        Node* expected = nullptr;
+        if(!_chunks[chunk].compare_exchange_strong(expected, nodes, std::memory_order_acq_rel, std::memory_order_acquire)){
+            destroyChunk(nodes);
+        }
+    }
+
+    static void destroyChunk(Node* nodes){
+        for(size_t index = 0; index < ChunkSize; ++index){
+            nodes[index].~Node();
+        }
+        std::allocator<Node>().deallocate(nodes, ChunkSize);
+    }
+};
+
+// IndexList whose slots are acquired and released from any thread while a
+// single thread links them. Producers construct elements with acquire() and
+// hand the slot to the linking thread, which owns the links, iteration and
+// size(). An unlinked slot can be released by any thread.
+template<class T, class Index = uint32_t, size_t ChunkSize = 1024>
+class ConcurrentIndexList{
+
+    public:
+    using value_type        = T;
+    using index_type        = Index;
+    using pool_type         = IndexConcurrentPool<T, Index, ChunkSize>;
+    using iterator          = IndexIterator<T,false,Index,ConcurrentIndexList>;
+    using reverse_iterator  = ReverseIndexIterator<T,Index,ConcurrentIndexList>;
+    using magazine_type     = typename pool_type::Magazine;
+
+    ConcurrentIndexList() = default;
+
+    // thread safe
+    template <class... Args>
+    Index acquire(Args&&... args){
+        return _pool.acquire(std::forward<Args>(args)...);
+    }
+    void release(Index slot){
+        _pool.release(slot);
+    }
+
+    // slot cache for one thread, see IndexConcurrentPool::Magazine
+    magazine_type magazine(){
+        return magazine_type(_pool);
+    }
+    template <class... Args>
+    Index acquire(magazine_type& magazine, Args&&... args){
+        return _pool.acquire(magazine, std::forward<Args>(args)...);
+    }
+    void release(magazine_type& magazine, Index slot){
+        _pool.release(magazine, slot);
+    }
+
+    T& data(Index slot){
+        return _pool.data(slot);
+    }
+
+    // everything below is for the linking thread only
+
+    iterator begin(){
+        return iterator(this,_pool.link(endIndex).getNext());
+    }
+    iterator end(){
+        return iterator(this,endIndex);
+    }
+    reverse_iterator rbegin(){
+        return reverse_iterator(this,_pool.link(endIndex).getPrevious());
+    }
+    reverse_iterator rend(){
+        return reverse_iterator(this,endIndex);
+    }
+
+    T& front(){
+        return _pool.data(_pool.link(endIndex).getNext());
+    }
+    T& back(){
+        return _pool.data(_pool.link(endIndex).getPrevious());
+    }
+
+    // links an acquired slot after it, like IndexList::insert
+    iterator link_after(iterator it, Index slot){
+        const Index current        = it.getCurrentIndex();
+        const Index currentNext    = _pool.link(current).getNext();
+
+        _pool.link(slot).setPrevious(current);
+        _pool.link(slot).setNext(currentNext);
+        _pool.link(currentNext).setPrevious(slot);
+        _pool.link(current).setNext(slot);
+        _size++;
+
+        return iterator(this, slot);
+    }
+    iterator link_front(Index slot){
+        return link_after(end(), slot);
+    }
+    iterator link_back(Index slot){
+        return link_after(iterator(this, _pool.link(endIndex).getPrevious()), slot);
+    }
+
+    // takes the element at it out of the list, the slot stays acquired
+    Index unlink(iterator it){
+        const Index current    = it.getCurrentIndex();
+        const Index previous   = _pool.link(current).getPrevious();
+        const Index next       = _pool.link(current).getNext();
+
+        _pool.link(next).setPrevious(previous);
+        _pool.link(previous).setNext(next);
+        _size--;
+
+        return current;
+    }
+
+    template <class... Args>
+    iterator emplace_back(Args&&... args){
+        return link_back(acquire(std::forward<Args>(args)...));
+    }
+
+    void erase(iterator it){
+        if(it != end()){
+            release(unlink(it));
+        }
+    }
+
+    size_t size() const{
+        return _size;
+    }
+    bool empty() const{
+        return (_size == 0);
+    }
+
+    pool_type _pool;
+
+    constexpr static Index endIndex = 0;
+
+    private:
+    size_t _size = 0;
+
+    // IndexIterator interface, pool order is not tracked here
+    bool isOrdered() const{
+        return false;
+    }
+    Index orderedAdvance(Index index, size_t, bool) const{
+        return index;
+    }
+
+    friend iterator;
+    friend reverse_iterator;
+};
+
+#endif // CONCURRENTINDEXLIST_H
@@ -0,0 +1,576 @@
+#ifndef INDEXFORWARDLIST_H
+#define INDEXFORWARDLIST_H
+
+#include "indexlist.h"
+
+// Payload storage of a forward node. Erased slots have no payload, the
+// storage holds the next slot of the erase list instead.
+template<class T, class Index, bool isTriviallyDestructible = std::is_trivially_destructible_v<T>>
+struct IndexForwardStorage{
+    IndexForwardStorage(){}
+    union{
+        T       value;
+        Index   nextErased;
+    };
+};
+
+template<class T, class Index>
+struct IndexForwardStorage<T, Index, false>{
+    IndexForwardStorage(){}
+    ~IndexForwardStorage(){}
+    union{
+        T       value;
+        Index   nextErased;
+    };
+};
+
+// Node of an IndexForwardList, a single link followed by the payload.
+// Erased slots are marked by a link pointing back to themselves.
+template<class T, class Index = index_t>
+struct IndexForwardNode{
+    public:
+
+    void setNext(Index next){_next = next;}
+    Index getNext() const {return _next;}
+
+    T& getData(){return _storage.value;}
+    const T& getData() const {return _storage.value;}
+
+    IndexForwardNode(Index next = 0) : _next(next){}
+
+    private:
+    Index _next;
+    IndexForwardStorage<T, Index> _storage;
+
+    template<class, class, class>
+    friend class IndexForwardPool;
+};
+
+// Array of IndexForwardNode, slot 0 is the list sentinel and holds no
+// payload. Same growth, relocation and allocator rules as IndexNodePool.
+template<class T, class Index = index_t, class Allocator = std::allocator<T>>
+class IndexForwardPool{
+    using node_type         = IndexForwardNode<T, Index>;
+    using node_allocator    = typename std::allocator_traits<Allocator>::template rebind_alloc<node_type>;
+    using node_traits       = std::allocator_traits<node_allocator>;
+    static_assert(std::is_same_v<typename node_traits::pointer, node_type*>, "IndexForwardPool needs an allocator returning raw pointers");
+
+    public:
+    using allocator_type    = Allocator;
+
+    IndexForwardPool() : IndexForwardPool(Allocator()){}
+    explicit IndexForwardPool(const Allocator& allocator) : _allocator(allocator){}
+    IndexForwardPool(const IndexForwardPool& other) : IndexForwardPool(other, Allocator(node_traits::select_on_container_copy_construction(other._allocator))){}
+    IndexForwardPool(const IndexForwardPool& other, const Allocator& allocator) : _allocator(allocator){
+        reallocate(other._size);
+        if constexpr(isIndexTriviallyRelocatable<T>){
+            if(other._size){
+                memcpy(static_cast<void*>(_nodes), other._nodes, other._size * sizeof(node_type));
+            }
+            _size = other._size;
+        }
+        else{
+            try{
+                for(; _size < other._size; ++_size){
+                    other.copyLinks(static_cast<Index>(_size), &_nodes[_size]);
+                    if(other.hasData(static_cast<Index>(_size))){
+                        new (&_nodes[_size].getData()) T(other._nodes[_size].getData());
+                    }
+                }
+            }
+            catch(...){
+                release();
+                throw;
+            }
+        }
+    }
+    IndexForwardPool(IndexForwardPool&& other) noexcept : _allocator(other._allocator){
+        swapStorage(other);
+    }
+    IndexForwardPool& operator = (const IndexForwardPool& other){
+        if(this != &other){
+            IndexForwardPool copy(other, Allocator(indexCopyAssignedAllocator(_allocator, other._allocator)));
+            swapStorage(copy);
+            if constexpr(node_traits::propagate_on_container_copy_assignment::value){
+                std::swap(_allocator, copy._allocator);
+            }
+        }
+        return *this;
+    }
+    // see IndexNodePool
+    IndexForwardPool& operator = (IndexForwardPool&& other) noexcept(isIndexMoveAssignCheap<node_allocator>){
+        if(this != &other){
+            if(isIndexMoveAssignCheap<node_allocator> || _allocator == other._allocator){
+                IndexForwardPool old(std::move(*this));
+                swapStorage(other);
+                if constexpr(node_traits::propagate_on_container_move_assignment::value){
+                    _allocator = other._allocator;
+                }
+            }
+            else if constexpr(!isIndexMoveAssignCheap<node_allocator>){
+                IndexForwardPool copy(other, Allocator(_allocator));
+                swapStorage(copy);
+            }
+        }
+        return *this;
+    }
+    ~IndexForwardPool(){
+        release();
+    }
+
+    // allocators are only exchanged when they propagate on swap, pools with
+    // unequal allocators must not be swapped otherwise
+    void swap(IndexForwardPool& other) noexcept{
+        swapStorage(other);
+        if constexpr(node_traits::propagate_on_container_swap::value){
+            std::swap(_allocator, other._allocator);
+        }
+    }
+
+    Allocator get_allocator() const {return Allocator(_allocator);}
+
+    node_type& operator [] (Index index){return _nodes[index];}
+
+    node_type& link(Index index){return _nodes[index];}
+    const node_type& link(Index index) const {return _nodes[index];}
+    T& data(Index index){return _nodes[index].getData();}
+    const T& data(Index index) const {return _nodes[index].getData();}
+
+    bool hasData(Index index) const{
+        return (index != 0 && _nodes[index].getNext() != index);
+    }
+
+    // next slot of the erase list after the erased slot index
+    Index nextErased(Index index) const{
+        return _nodes[index]._storage.nextErased;
+    }
+
+    // appends a slot without payload, used for the list sentinel
+    void emplaceLink(Index next){
+        if(_size == _capacity){
+            reallocate(std::max<size_t>(1, _capacity * 2));
+        }
+        new (&_nodes[_size]) node_type(next);
+        ++_size;
+    }
+
+    template <class... Args>
+    void emplace_back(Index next, Args&&... args){
+        if(_size == _capacity){
+            // the new payload is built before relocation as args may refer into the pool
+            const size_t newCapacity    = std::max<size_t>(1, _capacity * 2);
+            node_type* nodes            = node_traits::allocate(_allocator, newCapacity);
+            try{
+                new (&nodes[_size]) node_type(next);
+                new (&nodes[_size].getData()) T(std::forward<Args>(args)...);
+                try{
+                    relocate(nodes);
+                }
+                catch(...){
+                    nodes[_size].getData().~T();
+                    throw;
+                }
+            }
+            catch(...){
+                node_traits::deallocate(_allocator, nodes, newCapacity);
+                throw;
+            }
+            deallocate(_nodes, _capacity);
+            _nodes      = nodes;
+            _capacity   = newCapacity;
+        }
+        else{
+            new (&_nodes[_size]) node_type(next);
+            new (&_nodes[_size].getData()) T(std::forward<Args>(args)...);
+        }
+        ++_size;
+    }
+
+    // constructs the payload of an erased slot and links it. The payload
+    // shares its storage with the erase list link, a throwing constructor
+    // may have written over it, so the link is put back before rethrowing.
+    template <class... Args>
+    void assign(Index index, Index next, Args&&... args){
+        const Index nextErased = _nodes[index]._storage.nextErased;
+        try{
+            new (&_nodes[index].getData()) T(std::forward<Args>(args)...);
+        }
+        catch(...){
+            _nodes[index]._storage.nextErased = nextErased;
+            throw;
+        }
+        _nodes[index].setNext(next);
+    }
+
+    // destroys the payload of a live slot, marks it erased and stores the
+    // next slot of the erase list in it
+    void vacate(Index index, Index nextErased){
+        if constexpr(!std::is_trivially_destructible_v<T>){
+            _nodes[index].getData().~T();
+        }
+        _nodes[index].setNext(index);
+        _nodes[index]._storage.nextErased = nextErased;
+    }
+
+    size_t size() const {return _size;}
+    size_t capacity() const {return _capacity;}
+    void reserve(size_t nSize){
+        if(nSize > _capacity){
+            reallocate(nSize);
+        }
+    }
+
+    private:
+    node_allocator _allocator;
+    node_type* _nodes   = nullptr;
+    size_t _size        = 0;
+    size_t _capacity    = 0;
+
+    void swapStorage(IndexForwardPool& other) noexcept{
+        std::swap(_nodes, other._nodes);
+        std::swap(_size, other._size);
+        std::swap(_capacity, other._capacity);
+    }
+
+    void deallocate(node_type* nodes, size_t capacity){
+        if(nodes){
+            node_traits::deallocate(_allocator, nodes, capacity);
+        }
+    }
+
+    void release(){
+        for(; _size > 0; --_size){
+            if constexpr(!std::is_trivially_destructible_v<T>){
+                if(hasData(static_cast<Index>(_size - 1))){
+                    _nodes[_size - 1].getData().~T();
+                }
+            }
+            _nodes[_size - 1].~node_type();
+        }
+        deallocate(_nodes, _capacity);
+        _nodes      = nullptr;
+        _capacity   = 0;
+    }
+
+    // constructs node from slot index without payload, an erased slot keeps
+    // its erase list link
+    void copyLinks(Index index, node_type* node) const{
+        new (node) node_type(_nodes[index].getNext());
+        if(!hasData(index)){
+            node->_storage.nextErased = _nodes[index]._storage.nextErased;
+        }
+    }
+
+    // moves all slots into nodes, see indexRelocateNodes()
+    void relocate(node_type* nodes){
+        indexRelocateNodes<T>(_nodes, nodes, _size, [this](size_t index){
+            return hasData(static_cast<Index>(index));
+        }, [this](size_t index, node_type* node){
+            copyLinks(static_cast<Index>(index), node);
+        });
+    }
+
+    void reallocate(size_t newCapacity){
+        node_type* nodes = node_traits::allocate(_allocator, newCapacity);
+        try{
+            relocate(nodes);
+        }
+        catch(...){
+            node_traits::deallocate(_allocator, nodes, newCapacity);
+            throw;
+        }
+        deallocate(_nodes, _capacity);
+        _nodes      = nodes;
+        _capacity   = newCapacity;
+    }
+};
+
+template <class T, class Index, class List>
+class IndexForwardIterator{
+    public:
+    using difference_type   = std::ptrdiff_t;
+    using value_type        = std::remove_cv_t<T>;
+    using pointer           = T*;
+    using reference         = T&;
+    using iterator_category = std::forward_iterator_tag;
+    using index_type        = Index;
+
+    constexpr IndexForwardIterator() : _iList(nullptr),_current(0){}
+
+    bool operator != (const IndexForwardIterator& it) const{
+        return (_current != it._current);
+    }
+
+    bool operator == (const IndexForwardIterator& it) const{
+        return (_current == it._current);
+    }
+
+    IndexForwardIterator& operator++(){
+        _current = _iList->_pool.link(_current).getNext();
+        return *this;
+    }
+
+    IndexForwardIterator operator++(int){
+        auto it = *this;
+        ++(*this);
+        return it;
+    }
+
+    IndexForwardIterator operator+(size_t advance) const{
+        auto it = *this;
+        for(; advance > 0; --advance){
+            ++it;
+        }
+        return it;
+    }
+
+    T& operator*(void){
+        return _iList->_pool.data(_current);
+    }
+    T* operator->(void){
+        return &_iList->_pool.data(_current);
+    }
+
+    index_type getCurrentIndex() const {return _current;}
+
+    index_type getNextIndex() const {return _iList->_pool.link(_current).getNext();}
+
+    private:
+    List* _iList;
+    index_type _current;
+
+    constexpr IndexForwardIterator(List* iList, index_type index) : _iList(iList), _current(index) {}
+    friend List;
+};
+
+// Singly linked IndexList for queues and stacks, one link per node and one
+// link write per insert or erase. The list is circular through the sentinel
+// in slot 0 and remembers its last slot for push_back. Erasing works on the
+// element behind an iterator, like std::forward_list.
+template <class T, class Index = index_t, class Allocator = std::allocator<T>>
+class IndexForwardList{
+
+    public:
+    using value_type        = T;
+    using index_type        = Index;
+    using allocator_type    = Allocator;
+    using pool_type         = IndexForwardPool<T, Index, Allocator>;
+    using iterator          = IndexForwardIterator<T, Index, IndexForwardList>;
+
+    IndexForwardList() : IndexForwardList(Allocator()){}
+    explicit IndexForwardList(const Allocator& allocator) : _pool(allocator){_pool.emplaceLink(0);}
+    IndexForwardList(const IndexForwardList& other) = default;
+    IndexForwardList(const IndexForwardList& other, const Allocator& allocator) : _pool(other._pool, allocator),
+        _eraseListBegin(other._eraseListBegin), _back(other._back), _size(other._size){}
+    IndexForwardList(IndexForwardList&& other, const Allocator& allocator) : IndexForwardList(allocator){
+        if(get_allocator() == other.get_allocator()){
+            swap(other);
+        }
+        else{
+            IndexForwardList copy(other, allocator);
+            swap(copy);
+            other.clear();
+        }
+    }
+    // other is left empty with a fresh sentinel, see IndexList
+    IndexForwardList(IndexForwardList&& other) : IndexForwardList(other.get_allocator()){
+        swap(other);
+    }
+    IndexForwardList& operator = (const IndexForwardList& other) = default;
+    // see IndexList
+    IndexForwardList& operator = (IndexForwardList&& other) noexcept(std::allocator_traits<Allocator>::is_always_equal::value){
+        if(this != &other){
+            if(std::allocator_traits<Allocator>::is_always_equal::value || get_allocator() == other.get_allocator()){
+                swap(other);
+            }
+            else if constexpr(std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value){
+                pool_type sentinel(other.get_allocator());
+                sentinel.emplaceLink(0);
+                _pool       = std::move(other._pool);
+                other._pool = std::move(sentinel);
+                swapState(other);
+            }
+            else{
+                IndexForwardList copy(other, get_allocator());
+                swap(copy);
+            }
+            other.clear();
+        }
+        return *this;
+    }
+
+    // allocators are exchanged only when they propagate on swap
+    void swap(IndexForwardList& other) noexcept{
+        _pool.swap(other._pool);
+        swapState(other);
+    }
+    friend void swap(IndexForwardList& a, IndexForwardList& b) noexcept{
+        a.swap(b);
+    }
+
+    allocator_type get_allocator() const{
+        return _pool.get_allocator();
+    }
+
+    iterator before_begin(){
+        return iterator(this, endIndex);
+    }
+    iterator begin(){
+        return iterator(this, _pool.link(endIndex).getNext());
+    }
+    iterator end(){
+        return iterator(this, endIndex);
+    }
+
+    T& front(){
+        return _pool.data(_pool.link(endIndex).getNext());
+    }
+    T& back(){
+        return _pool.data(_back);
+    }
+
+    void reserve(size_t nSize){
+        checkCapacity(nSize+1);
+        _pool.reserve(nSize+1);
+    }
+
+    template <class... Args>
+    iterator emplace_after(const iterator& it, Args&&... args){
+        return emplace_after(it.getCurrentIndex(), std::forward<Args>(args)...);
+    }
+
+    template <class... Args>
+    iterator emplace_after(Index current, Args&&... args){
+        const Index currentNext = _pool.link(current).getNext();
+        Index newIndex          = static_cast<Index>(_pool.size());
+
+        if(_eraseListBegin == emptyEraseList){
+            checkCapacity(_pool.size()+1);
+            _pool.emplace_back(currentNext, std::forward<Args>(args)...);
+        }
+        else{
+            newIndex                = _eraseListBegin;
+            const Index nextErased  = _pool.nextErased(newIndex);
+            _pool.assign(newIndex, currentNext, std::forward<Args>(args)...);
+            _eraseListBegin         = nextErased;
+        }
+
+        _pool.link(current).setNext(newIndex);
+        if(current == _back){
+            _back = newIndex;
+        }
+        _size++;
+
+        return iterator(this, newIndex);
+    }
+
+    iterator insert_after(iterator it, const T& data){
+        return emplace_after(it.getCurrentIndex(), data);
+    }
+    iterator insert_after(iterator it, T&& data){
+        return emplace_after(it.getCurrentIndex(), std::move(data));
+    }
+
+    template <class... Args>
+    iterator emplace_front(Args&&... args){
+        return emplace_after(endIndex, std::forward<Args>(args)...);
+    }
+    template <class... Args>
+    iterator emplace_back(Args&&... args){
+        return emplace_after(_back, std::forward<Args>(args)...);
+    }
+
+    iterator push_front(const T& data){
+        return emplace_after(endIndex, data);
+    }
+    iterator push_front(T&& data){
+        return emplace_after(endIndex, std::move(data));
+    }
+    iterator push_back(const T& data){
+        return emplace_after(_back, data);
+    }
+    iterator push_back(T&& data){
+        return emplace_after(_back, std::move(data));
+    }
+
+    // erases the element behind it, returns iterator to the one after it
+    iterator erase_after(iterator it){
+        const Index current = it.getCurrentIndex();
+        const Index erased  = _pool.link(current).getNext();
+        if(erased == endIndex){
+            return end();
+        }
+        const Index next = _pool.link(erased).getNext();
+
+        _pool.link(current).setNext(next);
+        if(erased == _back){
+            _back = current;
+        }
+        _pool.vacate(erased, _eraseListBegin);
+        _eraseListBegin = erased;
+        _size--;
+
+        return iterator(this, next);
+    }
+
+    // erases (first, last)
+    iterator erase_after(iterator first, iterator last){
+        while(first.getNextIndex() != last.getCurrentIndex()){
+            erase_after(first);
+        }
+        return last;
+    }
+
+    void pop_front(){
+        erase_after(before_begin());
+    }
+
+    void clear(){
+        while(_size){
+            pop_front();
+        }
+    }
+
+    size_t size() const{
+        return _size;
+    }
+    bool empty() const{
+        return (_size == 0);
+    }
+
+    pool_type _pool;
+
+    constexpr static Index endIndex         = 0;
+    constexpr static Index emptyEraseList   = 0;
+    Index _eraseListBegin   = 0;
+    Index _back             = 0;
+    Index _size             = 0;
+
+    friend iterator;
+
+    // largest pool (sentinel included) addressable with Index
+    constexpr static size_t maxPoolSize     = std::numeric_limits<Index>::max();
+
+    private:
+
+    void swapState(IndexForwardList& other) noexcept{
+        std::swap(_eraseListBegin, other._eraseListBegin);
+        std::swap(_back, other._back);
+        std::swap(_size, other._size);
+    }
+
+    void checkCapacity(size_t poolSize) const{
+        if(poolSize > maxPoolSize){
+            throw std::length_error("IndexForwardList: index type too narrow for requested size");
+        }
+    }
+};
+
+#if __has_include(<memory_resource>)
+namespace pmr{
+    template<class T, class Index = index_t>
+    using IndexForwardList = ::IndexForwardList<T, Index, std::pmr::polymorphic_allocator<T>>;
+}
+#endif
+
+#endif // INDEXFORWARDLIST_H
@@ -1,396 +1,2425 @@
+#ifndef INDEXLIST_H
+#define INDEXLIST_H
+
 #include <vector>
 #include <string.h>
 #include <iostream>
 #include <algorithm>
 #include <cstddef>
 #include <utility>
+#include <limits>
+#include <stdexcept>
+#include <iterator>
+#include <initializer_list>
+#include <type_traits>
+#include <cstdint>
+#include <memory>
+#include <functional>
 
-template<class T>
-class IndexList;
+struct InterleavedIndexLayout;
 
 using index_t = size_t;
-template<class T>
-struct IndexNode{
-    public:
-    
 
-    void setPrevious(index_t previous){_previous = previous;}
-    void setNext(index_t next){_next = next;}
+template<class T, class Layout = InterleavedIndexLayout, class Index = index_t, class Allocator = std::allocator<T>>
+class IndexList;
 
-    index_t getPrevious()    const {return _previous;}
-    index_t getNext()        const {return _next;}
+template<class Index = index_t>
+struct IndexLink{
+    public:
 
-    T& getData(){return _data;}
+    void setPrevious(Index previous){_previous = previous;}
+    void setNext(Index next){_next = next;}
 
-    template <class... Args>
-    IndexNode(index_t previous, index_t next, Args&&... args) : _previous(previous),_next(next),_data(args...) {}
-    IndexNode(index_t previous, index_t next, const T& data)  : _previous(previous),_next(next), _data(data){}
-    IndexNode(index_t previous = 0, index_t next = 0)         : _previous(previous),_next(next){}
-    IndexNode(const IndexNode&) = default;
-    IndexNode(IndexNode&& other) noexcept = default;
-    IndexNode& operator = (const IndexNode&) = default;
-    IndexNode& operator = (IndexNode&&) noexcept = default;
+    Index getPrevious()    const {return _previous;}
+    Index getNext()        const {return _next;}
+
+    IndexLink(Index previous = 0, Index next = 0) : _previous(previous),_next(next){}
 
-    bool operator == (const IndexNode& other){
-        return (_previous == other.getPrevious() && _next == other.getNext()); 
+    bool operator == (const IndexLink& other){
+        return (_previous == other.getPrevious() && _next == other.getNext());
     }
 
-    private:
-    index_t _previous;
-    index_t _next;
-    T _data;
+    protected:
+    Index _previous;
+    Index _next;
+};
 
-    friend class IndexList<T>;
+// Payload storage of a node, the value only exists while the slot is live
+// and is constructed/destroyed by the pool owning the node.
+template<class T, bool isTriviallyDestructible = std::is_trivially_destructible_v<T>>
+struct IndexStorage{
+    IndexStorage(){}
+    union{
+        T value;
+    };
 };
 
-template <class T, bool isReverse = false>
-class IndexIterator{
+template<class T>
+struct IndexStorage<T, false>{
+    IndexStorage(){}
+    ~IndexStorage(){}
+    union{
+        T value;
+    };
+};
+
+template<class T, class Index = index_t>
+struct IndexNode : public IndexLink<Index>{
     public:
-    using difference_type   = std::ptrdiff_t;
-    using value_type        = std::remove_cv_t<T>;
-    using pointer           = T*;
-    using reference         = T&;
-    using iterator_category = std::bidirectional_iterator_tag;
 
-    constexpr IndexIterator() : _iList(nullptr),_current(0){}
+    T& getData(){return _storage.value;}
+    const T& getData() const {return _storage.value;}
 
-    IndexIterator& operator = (const IndexIterator& it){
-        _iList      = it._iList;
-        _current    = it._current;
-        return *this;
-    }
+    IndexNode(Index previous = 0, Index next = 0) : IndexLink<Index>(previous,next){}
 
-    bool operator != (const IndexIterator& it){
-        return (&_iList->_pool[_current] != &_iList->_pool[it._current]);
-    }
+    private:
+    IndexStorage<T> _storage;
 
-    bool operator == (const IndexIterator& it){
-        return (&_iList->_pool[_current] == &_iList->_pool[it._current]);
-    }    
+    template<class, class, class, class>
+    friend class IndexList;
+};
 
-  
-    IndexIterator& operator++(){ 
-        if constexpr(isReverse == true){
-            _current = _iList->_pool[_current].getPrevious();
+// Payloads that can be moved around with memcpy/memmove and need no
+// destruction when their slot is erased.
+template<class T>
+constexpr bool isIndexTriviallyRelocatable = std::is_trivially_copyable_v<T>;
+
+// Moves count nodes of an array pool into the uninitialised array target.
+// copyLinks(index, node) constructs node from slot index without payload,
+// live payloads (hasData(index)) are moved when that cannot throw and copied
+// otherwise, so a failure leaves nodes untouched. The payloads left behind
+// in nodes are destroyed on success.
+template<class T, class Node, class HasData, class CopyLinks>
+void indexRelocateNodes(Node* nodes, Node* target, size_t count, HasData hasData, CopyLinks copyLinks){
+    if constexpr(isIndexTriviallyRelocatable<T>){
+        if(count){
+            memcpy(static_cast<void*>(target), nodes, count * sizeof(Node));
         }
-        else{
-            _current = _iList->_pool[_current].getNext();
+    }
+    else{
+        size_t index = 0;
+        try{
+            for(; index < count; ++index){
+                copyLinks(index, &target[index]);
+                if(hasData(index)){
+                    new (&target[index].getData()) T(std::move_if_noexcept(nodes[index].getData()));
+                }
+            }
+        }
+        catch(...){
+            for(; index > 0; --index){
+                if(hasData(index - 1)){
+                    target[index - 1].getData().~T();
+                }
+            }
+            throw;
+        }
+        for(index = 0; index < count; ++index){
+            if(hasData(index)){
+                nodes[index].getData().~T();
+            }
         }
-        return *this;
     }
-    IndexIterator& operator--(){ 
-        if constexpr (isReverse == true){
-            _current = _iList->_pool[_current].getNext();
+}
+
+// Allocator a pool allocates its copy of other with when other is assigned
+// to it, pools follow the propagation rules of the standard containers.
+template<class Allocator>
+const Allocator& indexCopyAssignedAllocator(const Allocator& current, const Allocator& other){
+    if constexpr(std::allocator_traits<Allocator>::propagate_on_container_copy_assignment::value){
+        return other;
+    }
+    else{
+        return current;
+    }
+}
+
+template<class Allocator>
+constexpr bool isIndexMoveAssignCheap = std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value
+                                     || std::allocator_traits<Allocator>::is_always_equal::value;
+
+// bit scans of the occupancy bitmap, word must not be 0 for the first one
+inline size_t indexCountTrailingZeros(uint64_t word){
+#if defined(__GNUC__)
+    return static_cast<size_t>(__builtin_ctzll(word));
+#else
+    size_t count = 0;
+    for(; !(word & 1); word >>= 1){
+        ++count;
+    }
+    return count;
+#endif
+}
+
+// asks the cache to load the lines of [address, address + bytes), a no-op
+// where the compiler has no prefetch builtin
+inline void indexPrefetch(const void* address, size_t bytes){
+#if defined(__GNUC__)
+    constexpr uintptr_t lineSize = 64;
+    const uintptr_t first   = reinterpret_cast<uintptr_t>(address) & ~(lineSize - 1);
+    const uintptr_t last    = reinterpret_cast<uintptr_t>(address) + bytes;
+    for(uintptr_t line = first; line < last; line += lineSize){
+        __builtin_prefetch(reinterpret_cast<const void*>(line));
+    }
+#else
+    (void)address;
+    (void)bytes;
+#endif
+}
+
+inline size_t indexPopCount(uint64_t word){
+#if defined(__GNUC__)
+    return static_cast<size_t>(__builtin_popcountll(word));
+#else
+    size_t count = 0;
+    for(; word; word &= word - 1){
+        ++count;
+    }
+    return count;
+#endif
+}
+
+// Array-of-structures pool, links and payload of a slot share one IndexNode.
+// Only live slots hold a constructed payload; the link slots at the front
+// (list sentinels, added by emplaceLink()) and erased slots, marked by a link
+// pointing back to themselves, hold none. Node memory comes from Allocator
+// rebound to the node type, payloads are constructed in place.
+template<class T, class Index = index_t, class Allocator = std::allocator<T>>
+class IndexNodePool{
+    using node_type         = IndexNode<T, Index>;
+    using node_allocator    = typename std::allocator_traits<Allocator>::template rebind_alloc<node_type>;
+    using node_traits       = std::allocator_traits<node_allocator>;
+    static_assert(std::is_same_v<typename node_traits::pointer, node_type*>, "IndexNodePool needs an allocator returning raw pointers");
+
+    public:
+    using allocator_type    = Allocator;
+
+    IndexNodePool() : IndexNodePool(Allocator()){}
+    explicit IndexNodePool(const Allocator& allocator) : _allocator(allocator){}
+    IndexNodePool(const IndexNodePool& other) : IndexNodePool(other, Allocator(node_traits::select_on_container_copy_construction(other._allocator))){}
+    IndexNodePool(const IndexNodePool& other, const Allocator& allocator) : _allocator(allocator), _linkSlots(other._linkSlots){
+        reallocate(other._size);
+        if constexpr(isIndexTriviallyRelocatable<T>){
+            if(other._size){
+                memcpy(static_cast<void*>(_nodes), other._nodes, other._size * sizeof(node_type));
+            }
+            _size = other._size;
         }
         else{
-            _current = _iList->_pool[_current].getPrevious();
+            try{
+                for(; _size < other._size; ++_size){
+                    new (&_nodes[_size]) node_type(other.link(_size).getPrevious(), other.link(_size).getNext());
+                    if(other.hasData(_size)){
+                        new (&_nodes[_size].getData()) T(other._nodes[_size].getData());
+                    }
+                }
+            }
+            catch(...){
+                release();
+                throw;
+            }
+        }
+    }
+    IndexNodePool(IndexNodePool&& other) noexcept : _allocator(other._allocator){
+        swapStorage(other);
+    }
+    IndexNodePool& operator = (const IndexNodePool& other){
+        if(this != &other){
+            IndexNodePool copy(other, Allocator(indexCopyAssignedAllocator(_allocator, other._allocator)));
+            swapStorage(copy);
+            if constexpr(node_traits::propagate_on_container_copy_assignment::value){
+                std::swap(_allocator, copy._allocator);
+            }
+        }
+        return *this;
+    }
+    // nodes of other are taken over unless the allocators differ and do
+    // not propagate, the payloads are copied then
+    IndexNodePool& operator = (IndexNodePool&& other) noexcept(isIndexMoveAssignCheap<node_allocator>){
+        if(this != &other){
+            if(isIndexMoveAssignCheap<node_allocator> || _allocator == other._allocator){
+                IndexNodePool old(std::move(*this));
+                swapStorage(other);
+                if constexpr(node_traits::propagate_on_container_move_assignment::value){
+                    _allocator = other._allocator;
+                }
+            }
+            else if constexpr(!isIndexMoveAssignCheap<node_allocator>){
+                IndexNodePool copy(other, Allocator(_allocator));
+                swapStorage(copy);
+            }
         }
         return *this;
     }
+    ~IndexNodePool(){
+        release();
+    }
 
-    IndexIterator operator--(int){
-        auto it = *this;
-        --(*this);
-        return it;
+    // allocators are only exchanged when they propagate on swap, pools with
+    // unequal allocators must not be swapped otherwise
+    void swap(IndexNodePool& other) noexcept{
+        swapStorage(other);
+        if constexpr(node_traits::propagate_on_container_swap::value){
+            std::swap(_allocator, other._allocator);
+        }
     }
 
-    IndexIterator operator++(int){
-        auto it = *this;
-        ++(*this);
-        return it;
+    Allocator get_allocator() const {return Allocator(_allocator);}
+
+    node_type& operator [] (Index index){return _nodes[index];}
+
+    IndexLink<Index>& link(Index index){return _nodes[index];}
+    const IndexLink<Index>& link(Index index) const {return _nodes[index];}
+    T& data(Index index){return _nodes[index].getData();}
+    const T& data(Index index) const {return _nodes[index].getData();}
+
+    bool hasData(Index index) const{
+        return (index >= _linkSlots && _nodes[index].getPrevious() != index);
     }
 
-    IndexIterator operator+(index_t advance) const{
-        auto it = *this;
-        for(; advance > 0; --advance){
-            ++it;
+    // appends a slot without payload, used for list sentinels. Link slots
+    // have to precede all payload slots.
+    void emplaceLink(Index previous, Index next){
+        if(_size == _capacity){
+            reallocate(std::max<size_t>(1, _capacity * 2));
         }
-        return it;
+        new (&_nodes[_size]) node_type(previous, next);
+        ++_size;
+        ++_linkSlots;
     }
 
-    IndexIterator operator-(index_t advance) const{
-        auto it = *this;
-        for(; advance > 0; --advance){
-            --it;
+    template <class... Args>
+    void emplace_back(Index previous, Index next, Args&&... args){
+        if(_size == _capacity){
+            // the new payload is built before relocation as args may refer into the pool
+            const size_t newCapacity    = std::max<size_t>(1, _capacity * 2);
+            node_type* nodes            = node_traits::allocate(_allocator, newCapacity);
+            try{
+                new (&nodes[_size]) node_type(previous, next);
+                new (&nodes[_size].getData()) T(std::forward<Args>(args)...);
+                try{
+                    relocate(nodes);
+                }
+                catch(...){
+                    nodes[_size].getData().~T();
+                    throw;
+                }
+            }
+            catch(...){
+                node_traits::deallocate(_allocator, nodes, newCapacity);
+                throw;
+            }
+            deallocate(_nodes, _capacity);
+            _nodes      = nodes;
+            _capacity   = newCapacity;
+            ++_growthCount;
         }
-        return it;
+        else{
+            new (&_nodes[_size]) node_type(previous, next);
+            new (&_nodes[_size].getData()) T(std::forward<Args>(args)...);
+        }
+        ++_size;
     }
-   
-    T& operator*(void){
-        return _iList->_pool[_current].getData();
+
+    // constructs the payload of an erased slot and links it
+    template <class... Args>
+    void assign(Index index, Index previous, Index next, Args&&... args){
+        new (&_nodes[index].getData()) T(std::forward<Args>(args)...);
+        _nodes[index].setPrevious(previous);
+        _nodes[index].setNext(next);
     }
 
-    index_t getPreviousIndex() const{return _iList->_pool[_current].getPrevious();}
-    
-    index_t getCurrentIndex() const {return _current;}
-    
-    index_t getNextIndex() const {return _iList->_pool[_current].getNext();}
-    
-    
-    private:
-    IndexList<T>* _iList;
-    index_t _current;
+    void vacate(Index index){
+        if constexpr(!std::is_trivially_destructible_v<T>){
+            _nodes[index].getData().~T();
+        }
+    }
 
-    constexpr IndexIterator(IndexList<T>* iList, index_t index) : _iList(iList), _current(index) {}
-    friend class IndexList<T>;
-};
-template <class T>
-using ReverseIndexIterator = IndexIterator<T,true>;
+    // moves the payload of a live slot into an erased one
+    void moveData(Index from, Index to){
+        new (&_nodes[to].getData()) T(std::move(_nodes[from].getData()));
+        vacate(from);
+    }
 
-template <class T>
-class IndexList{
-    
-    public:
+    // memmove of count consecutive slots, links included
+    void moveRange(Index from, Index to, size_t count){
+        static_assert(isIndexTriviallyRelocatable<T>, "moveRange needs trivially relocatable payload");
+        memmove(static_cast<void*>(&_nodes[to]), &_nodes[from], count * sizeof(node_type));
+    }
 
-    IndexList(){_pool.emplace_back();}
-    IndexIterator<T> begin(){
-        return IndexIterator<T>(this,_pool[endIndex].getNext());
-    } 
-    IndexIterator<T> end(){
-        return IndexIterator<T>(this,endIndex);
+    size_t size() const {return _size;}
+    size_t capacity() const {return _capacity;}
+    // reallocations that grew the pool, each one moved every slot
+    size_t growthCount() const {return _growthCount;}
+    void reserve(size_t nSize){
+        if(nSize > _capacity){
+            reallocate(nSize);
+        }
+    }
+    void grow(size_t count){
+        if(_size + count > _capacity){
+            reallocate(std::max(_size + count, _capacity * 2));
+        }
     }
-    ReverseIndexIterator<T> rbegin(){
-        return ReverseIndexIterator<T>(this,_pool[endIndex].getPrevious());
-    } 
-    ReverseIndexIterator<T> rend(){
-        return ReverseIndexIterator<T>(this,endIndex);
+    // appends count slots left for the caller to fill byte-wise, returns
+    // their nodes
+    node_type* appendRaw(size_t count){
+        static_assert(isIndexTriviallyRelocatable<T>, "appendRaw needs trivially relocatable payload");
+        reserve(_size + count);
+        node_type* nodes = _nodes + _size;
+        _size += count;
+        return nodes;
+    }
+    // drops the slots from nSize on, O(1) when there is nothing to destroy
+    void truncate(size_t nSize){
+        if constexpr(std::is_trivially_destructible_v<node_type>){
+            _size = std::min(_size, nSize);
+        }
+        else{
+            for(; _size > nSize; --_size){
+                if(hasData(static_cast<Index>(_size - 1))){
+                    vacate(static_cast<Index>(_size - 1));
+                }
+                _nodes[_size - 1].~node_type();
+            }
+        }
+    }
+    void shrink_to_fit(){
+        if(_size != _capacity){
+            reallocate(_size);
+        }
     }
 
-    T& front(){
-        return _pool[_pool[endIndex].getNext()].getData();
+    private:
+    node_allocator _allocator;
+    node_type* _nodes   = nullptr;
+    size_t _size        = 0;
+    size_t _capacity    = 0;
+    size_t _linkSlots   = 0;
+    size_t _growthCount = 0;
+
+    void swapStorage(IndexNodePool& other) noexcept{
+        std::swap(_nodes, other._nodes);
+        std::swap(_size, other._size);
+        std::swap(_capacity, other._capacity);
+        std::swap(_linkSlots, other._linkSlots);
+        std::swap(_growthCount, other._growthCount);
     }
 
-    T& back(){
-        return _pool[_pool[endIndex].getPrevious()].getData();
-    } 
+    void deallocate(node_type* nodes, size_t capacity){
+        if(nodes){
+            node_traits::deallocate(_allocator, nodes, capacity);
+        }
+    }
 
-    void reserve(index_t nSize){
-        _pool.reserve(nSize+1);
+    void release(){
+        truncate(0);
+        deallocate(_nodes, _capacity);
+        _nodes      = nullptr;
+        _capacity   = 0;
     }
 
-    IndexIterator<T> insert(IndexIterator<T> it, const T& data){
-        const index_t current        = it.getCurrentIndex();
-        const index_t currentNext    = _pool[current].getNext();
-        index_t newIndex             = _pool.size();
+    // moves all slots into nodes, see indexRelocateNodes()
+    void relocate(node_type* nodes){
+        indexRelocateNodes<T>(_nodes, nodes, _size, [this](size_t index){
+            return hasData(static_cast<Index>(index));
+        }, [this](size_t index, node_type* node){
+            new (node) node_type(_nodes[index].getPrevious(), _nodes[index].getNext());
+        });
+    }
 
-        if(_eraseListBegin == endIndex){
-            _pool.push_back(IndexNode<T>(current, currentNext, data));
+    void reallocate(size_t newCapacity){
+        node_type* nodes = node_traits::allocate(_allocator, newCapacity);
+        try{
+            relocate(nodes);
         }
-        else{
-            newIndex        = _eraseListBegin;
-            _eraseListBegin = _pool[_eraseListBegin].getNext();
-            _pool[newIndex] = IndexNode<T>(current, currentNext, data);
-
-        }   
-        _pool[currentNext].setPrevious(newIndex);
-        _pool[current].setNext(newIndex);
-        
-        _size++;
+        catch(...){
+            node_traits::deallocate(_allocator, nodes, newCapacity);
+            throw;
+        }
+        deallocate(_nodes, _capacity);
+        if(newCapacity > _capacity){
+            ++_growthCount;
+        }
+        _nodes      = nodes;
+        _capacity   = newCapacity;
+    }
+};
+
+// Proxy returned by IndexSplitPool::operator[], mimics the IndexNode interface.
+template<class T, class Index = index_t>
+struct IndexNodeRef{
+    public:
+
+    void setPrevious(Index previous){_link.setPrevious(previous);}
+    void setNext(Index next){_link.setNext(next);}
+
+    Index getPrevious()    const {return _link.getPrevious();}
+    Index getNext()        const {return _link.getNext();}
+
+    T& getData(){return _data;}
+
+    IndexNodeRef(IndexLink<Index>& link, T& data) : _link(link), _data(data){}
+
+    private:
+    IndexLink<Index>& _link;
+    T& _data;
+};
 
-        return IndexIterator<T>(this, newIndex);
-        
-       // _pool[current].set
-        
+// Structure-of-arrays pool, links are kept in their own dense array so walking
+// and relinking the list never pulls payload cache lines. Payload slots follow
+// the same liveness rules as IndexNodePool. Both arrays are allocated with
+// Allocator.
+template<class T, class Index = index_t, class Allocator = std::allocator<T>>
+class IndexSplitPool{
+    using data_allocator    = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+    using data_traits       = std::allocator_traits<data_allocator>;
+    using link_allocator    = typename std::allocator_traits<Allocator>::template rebind_alloc<IndexLink<Index>>;
+    static_assert(std::is_same_v<typename data_traits::pointer, T*>, "IndexSplitPool needs an allocator returning raw pointers");
+
+    public:
+    using allocator_type    = Allocator;
+
+    IndexSplitPool() : IndexSplitPool(Allocator()){}
+    explicit IndexSplitPool(const Allocator& allocator) : _allocator(allocator), _links(link_allocator(allocator)){}
+    IndexSplitPool(const IndexSplitPool& other) : IndexSplitPool(other, Allocator(data_traits::select_on_container_copy_construction(other._allocator))){}
+    IndexSplitPool(const IndexSplitPool& other, const Allocator& allocator) : _allocator(allocator), _links(other._links, link_allocator(allocator)), _linkSlots(other._linkSlots){
+        _data           = data_traits::allocate(_allocator, _links.size());
+        _dataCapacity   = _links.size();
+        if constexpr(isIndexTriviallyRelocatable<T>){
+            if(_dataCapacity){
+                memcpy(static_cast<void*>(_data), other._data, _dataCapacity * sizeof(T));
+            }
+        }
+        else{
+            size_t index = 0;
+            try{
+                for(; index < _links.size(); ++index){
+                    if(hasData(static_cast<Index>(index))){
+                        new (&_data[index]) T(other._data[index]);
+                    }
+                }
+            }
+            catch(...){
+                _links.resize(index);
+                truncate(0);
+                deallocate(_data, _dataCapacity);
+                throw;
+            }
+        }
+    }
+    IndexSplitPool(IndexSplitPool&& other) noexcept : _allocator(other._allocator), _links(link_allocator(other._allocator)){
+        swapStorage(other);
+    }
+    IndexSplitPool& operator = (const IndexSplitPool& other){
+        if(this != &other){
+            IndexSplitPool copy(other, Allocator(indexCopyAssignedAllocator(_allocator, other._allocator)));
+            if constexpr(data_traits::propagate_on_container_copy_assignment::value){
+                replaceWith(std::move(copy));
+            }
+            else{
+                swapStorage(copy);
+            }
+        }
+        return *this;
+    }
+    // see IndexNodePool
+    IndexSplitPool& operator = (IndexSplitPool&& other) noexcept(isIndexMoveAssignCheap<data_allocator>){
+        if(this != &other){
+            if constexpr(data_traits::propagate_on_container_move_assignment::value){
+                replaceWith(std::move(other));
+            }
+            else if(isIndexMoveAssignCheap<data_allocator> || _allocator == other._allocator){
+                IndexSplitPool old(std::move(*this));
+                swapStorage(other);
+            }
+            else if constexpr(!isIndexMoveAssignCheap<data_allocator>){
+                IndexSplitPool copy(other, Allocator(_allocator));
+                swapStorage(copy);
+            }
+        }
+        return *this;
+    }
+    ~IndexSplitPool(){
+        truncate(0);
+        deallocate(_data, _dataCapacity);
     }
 
-    IndexIterator<T> push_front(const T& data){
-        return insert(end(),data);
+    void swap(IndexSplitPool& other) noexcept{
+        swapStorage(other);
+        if constexpr(data_traits::propagate_on_container_swap::value){
+            std::swap(_allocator, other._allocator);
+        }
     }
 
-    IndexIterator<T> push_back(const T& data){
-        return insert(IndexIterator<T>(this, _pool[endIndex].getPrevious()),data);
+    Allocator get_allocator() const {return Allocator(_allocator);}
+
+    IndexNodeRef<T, Index> operator [] (Index index){return IndexNodeRef<T, Index>(_links[index], _data[index]);}
+
+    IndexLink<Index>& link(Index index){return _links[index];}
+    const IndexLink<Index>& link(Index index) const {return _links[index];}
+    T& data(Index index){return _data[index];}
+    const T& data(Index index) const {return _data[index];}
+
+    bool hasData(Index index) const{
+        return (index >= _linkSlots && _links[index].getPrevious() != index);
     }
 
-    
-    
+    void emplaceLink(Index previous, Index next){
+        if(_links.size() == _dataCapacity){
+            reallocate(std::max<size_t>(1, _dataCapacity * 2));
+        }
+        _links.emplace_back(previous, next);
+        ++_linkSlots;
+    }
 
     template <class... Args>
-    IndexIterator<T> emplace(const IndexIterator<T>& it, Args&&... args){
-        const index_t current        = it.getCurrentIndex();
-        const index_t currentNext    = _pool[current].getNext();
-        index_t newIndex             = _pool.size();
-        
-        
-        if(_eraseListBegin == emptyEraseList){
-            _pool.emplace_back(current, currentNext, args...);
+    void emplace_back(Index previous, Index next, Args&&... args){
+        const size_t index = _links.size();
+        if(index == _dataCapacity){
+            // the new payload is built before relocation as args may refer into the pool
+            const size_t newCapacity    = std::max<size_t>(1, _dataCapacity * 2);
+            T* data                     = data_traits::allocate(_allocator, newCapacity);
+            try{
+                _links.reserve(newCapacity);
+                new (&data[index]) T(std::forward<Args>(args)...);
+                try{
+                    relocate(data);
+                }
+                catch(...){
+                    data[index].~T();
+                    throw;
+                }
+            }
+            catch(...){
+                data_traits::deallocate(_allocator, data, newCapacity);
+                throw;
+            }
+            deallocate(_data, _dataCapacity);
+            _data           = data;
+            _dataCapacity   = newCapacity;
+            ++_growthCount;
         }
         else{
-            newIndex        = _eraseListBegin;
-            _eraseListBegin = _pool[_eraseListBegin].getNext();
-            _pool[newIndex] = IndexNode<T>(current, currentNext, args...);
-             
+            new (&_data[index]) T(std::forward<Args>(args)...);
         }
-
-        _pool[currentNext].setPrevious(newIndex);
-        _pool[current].setNext(newIndex);
-        
-        _size++;
-        
-        return IndexIterator<T>(this, newIndex);
+        _links.emplace_back(previous, next);
     }
 
     template <class... Args>
-    IndexIterator<T> emplace( index_t current, Args&&... args){
-        
-        index_t currentNext    = _pool[current].getNext();
-        index_t newIndex       = _pool.size();
-        
-        
-        if(_eraseListBegin == emptyEraseList){
-            _pool.emplace_back(current, currentNext, args...);
+    void assign(Index index, Index previous, Index next, Args&&... args){
+        new (&_data[index]) T(std::forward<Args>(args)...);
+        _links[index] = IndexLink<Index>(previous, next);
+    }
+
+    void vacate(Index index){
+        if constexpr(!std::is_trivially_destructible_v<T>){
+            _data[index].~T();
         }
-        else{
-            newIndex        = _eraseListBegin;
-            _eraseListBegin = _pool[_eraseListBegin].getNext();
-            _pool[newIndex] = IndexNode<T>(current, currentNext, args...);
-            
-        }
-        
-        _pool[currentNext].setPrevious(newIndex);
-        _pool[current].setNext(newIndex);
-        
-        _size++;
+    }
 
-        return IndexIterator<T>(this, newIndex);
+    void moveData(Index from, Index to){
+        new (&_data[to]) T(std::move(_data[from]));
+        vacate(from);
     }
 
-    template <class... Args>
-    IndexIterator<T> emplace_front(Args&&... args){
-        return emplace(end(),args...);
+    // memmove of count consecutive payloads, links are left as they are
+    void moveRange(Index from, Index to, size_t count){
+        static_assert(isIndexTriviallyRelocatable<T>, "moveRange needs trivially relocatable payload");
+        memmove(static_cast<void*>(&_data[to]), &_data[from], count * sizeof(T));
     }
 
-    template <class... Args>
-    IndexIterator<T> emplace_back(Args&&... args){
-       
-        return emplace( _pool[endIndex].getPrevious(),args...);
-    }
-
-    
-    void erase(IndexIterator<T> it){
-        if(it != end()){
-            const index_t current    = it.getCurrentIndex();
-            const index_t previous   = _pool[current].getPrevious();
-            const index_t next       = _pool[current].getNext();
-            
-            _pool[next].setPrevious(previous);
-            _pool[previous].setNext(next);
-
-            _pool[current] = IndexNode<T>(0,0,{});//_pool[current] = IndexNode<T>(0,0,{});
-            _pool[current].setNext(_eraseListBegin);
-            _pool[current].setPrevious(current);
-
-            _eraseListBegin = current;         
-            _size--;
+    size_t size() const {return _links.size();}
+    size_t capacity() const {return std::min(_links.capacity(), _dataCapacity);}
+    // reallocations that grew the payload array
+    size_t growthCount() const {return _growthCount;}
+    void reserve(size_t nSize){
+        if(nSize > _dataCapacity){
+            reallocate(nSize);
+        }
+    }
+    void grow(size_t count){
+        if(_links.size() + count > _dataCapacity){
+            reallocate(std::max(_links.size() + count, _dataCapacity * 2));
+        }
+    }
+    void truncate(size_t nSize){
+        if constexpr(!std::is_trivially_destructible_v<T>){
+            for(size_t index = nSize; index < _links.size(); ++index){
+                if(hasData(static_cast<Index>(index))){
+                    vacate(static_cast<Index>(index));
+                }
+            }
+        }
+        if(nSize < _links.size()){
+            _links.resize(nSize);
+        }
+    }
+    void shrink_to_fit(){
+        _links.shrink_to_fit();
+        if(_links.size() != _dataCapacity){
+            reallocate(_links.size());
         }
     }
 
-    void pop_front(){
-        erase(begin());
+    private:
+    data_allocator _allocator;
+    std::vector<IndexLink<Index>, link_allocator> _links;
+    T* _data                = nullptr;
+    size_t _dataCapacity    = 0;
+    size_t _linkSlots       = 0;
+    size_t _growthCount     = 0;
+
+    // takes over storage and allocator of other. The link vector only gets
+    // an allocator on construction, so the pool is built anew in place.
+    void replaceWith(IndexSplitPool&& other) noexcept{
+        this->~IndexSplitPool();
+        new (this) IndexSplitPool(std::move(other));
     }
 
-    void pop_back(){
-        erase(IndexIterator<T>(this, _pool[endIndex].getPrevious()));
+    // the link vectors are swapped along, their allocators compare equal
+    // wherever this is used
+    void swapStorage(IndexSplitPool& other) noexcept{
+        _links.swap(other._links);
+        std::swap(_data, other._data);
+        std::swap(_dataCapacity, other._dataCapacity);
+        std::swap(_linkSlots, other._linkSlots);
+        std::swap(_growthCount, other._growthCount);
     }
-    
-    void clear(){
-        while(begin() != end()){
-            pop_front();
+
+    void deallocate(T* data, size_t capacity){
+        if(data){
+            data_traits::deallocate(_allocator, data, capacity);
         }
     }
 
-    void resize(index_t newSize){
-        if(_size < newSize){
-            for(index_t i = 0, sizeDiff = newSize - _size ; i < sizeDiff; i++){
-                emplace_back();
+    void relocate(T* data){
+        if constexpr(isIndexTriviallyRelocatable<T>){
+            if(_links.size()){
+                memcpy(static_cast<void*>(data), _data, _links.size() * sizeof(T));
             }
         }
-        else if(_size > newSize){
-            for(index_t i = 0, sizeDiff = _size - newSize ; i < sizeDiff; i++){
-                pop_back();
+        else{
+            size_t index = 0;
+            try{
+                for(; index < _links.size(); ++index){
+                    if(hasData(static_cast<Index>(index))){
+                        new (&data[index]) T(std::move_if_noexcept(_data[index]));
+                    }
+                }
+            }
+            catch(...){
+                for(; index > 0; --index){
+                    if(hasData(static_cast<Index>(index - 1))){
+                        data[index - 1].~T();
+                    }
+                }
+                throw;
             }
+            for(index = 0; index < _links.size(); ++index){
+                if(hasData(static_cast<Index>(index))){
+                    vacate(static_cast<Index>(index));
+                }
+            }
+        }
+    }
+
+    void reallocate(size_t newCapacity){
+        _links.reserve(newCapacity);
+        T* data = data_traits::allocate(_allocator, newCapacity);
+        try{
+            relocate(data);
+        }
+        catch(...){
+            data_traits::deallocate(_allocator, data, newCapacity);
+            throw;
+        }
+        deallocate(_data, _dataCapacity);
+        if(newCapacity > _dataCapacity){
+            ++_growthCount;
         }
-        
+        _data           = data;
+        _dataCapacity   = newCapacity;
     }
+};
 
+// Array-of-structures pool grown in fixed-size chunks, nodes never move so
+// growth is O(ChunkSize) and references to elements stay valid. Chunks and
+// the chunk table are allocated with Allocator.
+template<class T, class Index = index_t, size_t ChunkSize = 1024, class Allocator = std::allocator<T>>
+class IndexSegmentedPool{
+    static_assert(ChunkSize > 0 && (ChunkSize & (ChunkSize - 1)) == 0, "ChunkSize has to be a power of two");
 
-    void shrink_to_fit(){
-        (void)std::partition(_pool.begin() + 1, _pool.end(), [this](const auto& node){
-            return !isNodeErased(node);
-        });
+    using node_type         = IndexNode<T, Index>;
+    using node_allocator    = typename std::allocator_traits<Allocator>::template rebind_alloc<node_type>;
+    using node_traits       = std::allocator_traits<node_allocator>;
+    using chunk_allocator   = typename std::allocator_traits<Allocator>::template rebind_alloc<node_type*>;
+    static_assert(std::is_same_v<typename node_traits::pointer, node_type*>, "IndexSegmentedPool needs an allocator returning raw pointers");
+
+    public:
+    using allocator_type    = Allocator;
+
+    IndexSegmentedPool() : IndexSegmentedPool(Allocator()){}
+    explicit IndexSegmentedPool(const Allocator& allocator) : _allocator(allocator), _chunks(chunk_allocator(allocator)){}
+    IndexSegmentedPool(const IndexSegmentedPool& other) : IndexSegmentedPool(other, Allocator(node_traits::select_on_container_copy_construction(other._allocator))){}
+    IndexSegmentedPool(const IndexSegmentedPool& other, const Allocator& allocator) : _allocator(allocator), _chunks(chunk_allocator(allocator)), _linkSlots(other._linkSlots){
+        reserve(other._size);
+        try{
+            for(; _size < other._size; ++_size){
+                new (slot(_size)) node_type(other.link(_size).getPrevious(), other.link(_size).getNext());
+                if(other.hasData(_size)){
+                    new (&node(_size).getData()) T(other.node(_size).getData());
+                }
+            }
+        }
+        catch(...){
+            truncate(0);
+            shrink_to_fit();
+            throw;
+        }
+    }
+    IndexSegmentedPool(IndexSegmentedPool&& other) noexcept : _allocator(other._allocator), _chunks(chunk_allocator(other._allocator)){
+        swapStorage(other);
+    }
+    IndexSegmentedPool& operator = (const IndexSegmentedPool& other){
+        if(this != &other){
+            IndexSegmentedPool copy(other, Allocator(indexCopyAssignedAllocator(_allocator, other._allocator)));
+            if constexpr(node_traits::propagate_on_container_copy_assignment::value){
+                replaceWith(std::move(copy));
+            }
+            else{
+                swapStorage(copy);
+            }
+        }
+        return *this;
+    }
+    // see IndexNodePool
+    IndexSegmentedPool& operator = (IndexSegmentedPool&& other) noexcept(isIndexMoveAssignCheap<node_allocator>){
+        if(this != &other){
+            if constexpr(node_traits::propagate_on_container_move_assignment::value){
+                replaceWith(std::move(other));
+            }
+            else if(isIndexMoveAssignCheap<node_allocator> || _allocator == other._allocator){
+                IndexSegmentedPool old(std::move(*this));
+                swapStorage(other);
+            }
+            else if constexpr(!isIndexMoveAssignCheap<node_allocator>){
+                IndexSegmentedPool copy(other, Allocator(_allocator));
+                swapStorage(copy);
+            }
+        }
+        return *this;
+    }
+    ~IndexSegmentedPool(){
+        truncate(0);
+        shrink_to_fit();
+    }
 
-        for(index_t index = 1; index <= _size; ++index){
-            _pool[index]._next      = index + 1;
-            _pool[index]._previous  = index - 1;
+    void swap(IndexSegmentedPool& other) noexcept{
+        swapStorage(other);
+        if constexpr(node_traits::propagate_on_container_swap::value){
+            std::swap(_allocator, other._allocator);
         }
+    }
 
-        _eraseListBegin = emptyEraseList;
+    Allocator get_allocator() const {return Allocator(_allocator);}
 
-        _pool.resize(_size+1);
-        _pool.shrink_to_fit();
+    node_type& operator [] (Index index){return node(index);}
+
+    IndexLink<Index>& link(Index index){return node(index);}
+    const IndexLink<Index>& link(Index index) const {return node(index);}
+    T& data(Index index){return node(index).getData();}
+    const T& data(Index index) const {return node(index).getData();}
 
-        _pool[endIndex].setPrevious(_size);
-        _pool[endIndex].setNext(endIndex+1);
-        _pool[_size].setNext(endIndex);
+    bool hasData(Index index) const{
+        return (index >= _linkSlots && node(index).getPrevious() != index);
     }
 
-    void reorder(){
-        (void)std::partition(_pool.begin() + 1, _pool.end(), [this](const auto& node){
-            return !isNodeErased(node);
-        });
+    void emplaceLink(Index previous, Index next){
+        if(_size == capacity()){
+            addChunk();
+        }
+        new (slot(_size)) node_type(previous, next);
+        ++_size;
+        ++_linkSlots;
+    }
 
-        for(index_t index = 1; index <= _size; ++index){
-            _pool[index]._next      = index + 1;
-            _pool[index]._previous  = index - 1;
+    template <class... Args>
+    void emplace_back(Index previous, Index next, Args&&... args){
+        if(_size == capacity()){
+            addChunk();
         }
+        new (slot(_size)) node_type(previous, next);
+        new (&slot(_size)->getData()) T(std::forward<Args>(args)...);
+        ++_size;
+    }
 
-        _eraseListBegin = _pool.size() - 1;
+    template <class... Args>
+    void assign(Index index, Index previous, Index next, Args&&... args){
+        new (&node(index).getData()) T(std::forward<Args>(args)...);
+        node(index).setPrevious(previous);
+        node(index).setNext(next);
+    }
 
-        for(index_t end = _pool.size() - 1; end > _size; --end){
-            _pool[end]._next        = end - 1;
-            _pool[end]._previous    = end;
+    void vacate(Index index){
+        if constexpr(!std::is_trivially_destructible_v<T>){
+            node(index).getData().~T();
         }
+    }
 
-        _pool[_size + 1]._next = 0;
+    void moveData(Index from, Index to){
+        new (&node(to).getData()) T(std::move(node(from).getData()));
+        vacate(from);
+    }
 
-        _pool[endIndex].setPrevious(_size);
-        _pool[endIndex].setNext(endIndex+1);
-        _pool[_size].setNext(endIndex);
+    // chunks are not contiguous, slots are copied one by one
+    void moveRange(Index from, Index to, size_t count){
+        static_assert(isIndexTriviallyRelocatable<T>, "moveRange needs trivially relocatable payload");
+        for(size_t index = 0; index < count; ++index){
+            memcpy(static_cast<void*>(slot(to + index)), slot(from + index), sizeof(node_type));
+        }
     }
-    
 
-    index_t size() const{
-        return _size;
+    size_t size() const {return _size;}
+    size_t capacity() const {return _chunks.size() * ChunkSize;}
+    // chunks added, growth never moves nodes
+    size_t growthCount() const {return _growthCount;}
+    void reserve(size_t nSize){
+        while(capacity() < nSize){
+            addChunk();
+        }
     }
-    index_t capacity() const{
-        return (_pool.capacity() - 1);
+    void grow(size_t count){reserve(_size + count);}
+    void truncate(size_t nSize){
+        if constexpr(std::is_trivially_destructible_v<node_type>){
+            _size = std::min(_size, nSize);
+        }
+        else{
+            for(; _size > nSize; --_size){
+                if(hasData(static_cast<Index>(_size - 1))){
+                    vacate(static_cast<Index>(_size - 1));
+                }
+                node(_size - 1).~node_type();
+            }
+        }
     }
-
-    bool empty() const{
-        return (_size == 0);
+    void shrink_to_fit(){
+        const size_t used = (_size + ChunkSize - 1) / ChunkSize;
+        for(size_t chunk = used; chunk < _chunks.size(); ++chunk){
+            node_traits::deallocate(_allocator, _chunks[chunk], ChunkSize);
+        }
+        _chunks.resize(used);
+        _chunks.shrink_to_fit();
     }
 
-    
-    T& operator [] (index_t index){
-        
-        return _pool[index + (!index)].getData();    
+    private:
+    constexpr static size_t chunkMask = ChunkSize - 1;
+
+    node_allocator _allocator;
+    std::vector<node_type*, chunk_allocator> _chunks;
+    size_t _size        = 0;
+    size_t _linkSlots   = 0;
+    size_t _growthCount = 0;
+
+    // see IndexSplitPool
+    void replaceWith(IndexSegmentedPool&& other) noexcept{
+        this->~IndexSegmentedPool();
+        new (this) IndexSegmentedPool(std::move(other));
     }
-    ~IndexList(){
 
+    // the chunk tables are swapped along, their allocators compare equal
+    // wherever this is used
+    void swapStorage(IndexSegmentedPool& other) noexcept{
+        _chunks.swap(other._chunks);
+        std::swap(_size, other._size);
+        std::swap(_linkSlots, other._linkSlots);
+        std::swap(_growthCount, other._growthCount);
     }
-    bool isNodeErased(const IndexNode<T>& node) const{
-        return (_pool[node.getPrevious()].getNext() == node.getNext());
-    }
-    index_t getNodeIndex(const IndexNode<T>& node) const{
-        return _pool[node.getPrevious()].getNext();
+
+    void addChunk(){
+        _chunks.push_back(node_traits::allocate(_allocator, ChunkSize));
+        ++_growthCount;
     }
 
-    std::vector< IndexNode<T>> _pool;
-    //private:
+    node_type* slot(size_t index) const {return _chunks[index / ChunkSize] + (index & chunkMask);}
+    node_type& node(size_t index) const {return *slot(index);}
+};
+
+// Generational reference to an element, survives erase/reuse of other slots,
+// reorder() and shrink_to_fit(). Default constructed handle is never valid.
+template<class Index = index_t>
+struct IndexHandle{
+    using generation_type = uint32_t;
+
+    Index           key         = 0;
+    generation_type generation  = 0;
 
-    constexpr static index_t endIndex        = 0;
-    constexpr static index_t emptyEraseList  = 0;
-    index_t _eraseListBegin = 0;
-    index_t _size = 0;
+    bool operator == (const IndexHandle& other) const {return (key == other.key && generation == other.generation);}
+    bool operator != (const IndexHandle& other) const {return !(*this == other);}
+};
+
+// Pool state reported by IndexList::stats()
+struct IndexListStats{
+    size_t  liveNodes           = 0;
+    // slots without element, the sentinel not counted
+    size_t  freeSlots           = 0;
+    // free slots on the erase list, a running reorderStep() keeps some off it
+    size_t  eraseListLength     = 0;
+    size_t  capacity            = 0;
+    // mean slot distance between neighbouring elements, 1 in pool order
+    double  averageLinkDistance = 0;
+    size_t  growthCount         = 0;
+
+    // share of the used slots holding no element
+    double fragmentation() const{
+        return (liveNodes + freeSlots) ? static_cast<double>(freeSlots) / static_cast<double>(liveNodes + freeSlots) : 0.0;
+    }
+};
 
-    friend class IndexIterator<T>;
+struct InterleavedIndexLayout{
+    template<class T, class Index, class Allocator = std::allocator<T>>
+    using pool = IndexNodePool<T, Index, Allocator>;
 };
+
+struct SplitIndexLayout{
+    template<class T, class Index, class Allocator = std::allocator<T>>
+    using pool = IndexSplitPool<T, Index, Allocator>;
+};
+
+template<size_t ChunkSize = 1024>
+struct SegmentedIndexLayout{
+    template<class T, class Index, class Allocator = std::allocator<T>>
+    using pool = IndexSegmentedPool<T, Index, ChunkSize, Allocator>;
+};
+
+template <class T, bool isReverse = false, class Index = index_t, class List = IndexList<T, InterleavedIndexLayout, Index>>
+class IndexIterator{
+    public:
+    using difference_type   = std::ptrdiff_t;
+    using value_type        = std::remove_cv_t<T>;
+    using pointer           = T*;
+    using reference         = T&;
+    using iterator_category = std::bidirectional_iterator_tag;
+    using index_type        = Index;
+
+    constexpr IndexIterator() : _iList(nullptr),_current(0){}
+
+    constexpr IndexIterator(const IndexIterator&) = default;
+    IndexIterator& operator = (const IndexIterator&) = default;
+
+    // iterator converts to const_iterator
+    template <class Other, class OtherList, class = std::enable_if_t<std::is_same_v<const Other, T> && !std::is_same_v<Other, T> && std::is_same_v<const OtherList, List>>>
+    constexpr IndexIterator(const IndexIterator<Other, isReverse, Index, OtherList>& it) : _iList(it._iList), _current(it._current){}
+
+    // iterators into the same list are compared by slot, const and mutable
+    // ones mix
+    template <class Other, class OtherList>
+    bool operator != (const IndexIterator<Other, isReverse, Index, OtherList>& it) const{
+        return (_current != it.getCurrentIndex());
+    }
+
+    template <class Other, class OtherList>
+    bool operator == (const IndexIterator<Other, isReverse, Index, OtherList>& it) const{
+        return (_current == it.getCurrentIndex());
+    }
+
+
+    IndexIterator& operator++(){
+        if constexpr(isReverse == true){
+            _current = _iList->_pool.link(_current).getPrevious();
+        }
+        else{
+            _current = _iList->_pool.link(_current).getNext();
+        }
+        return *this;
+    }
+    IndexIterator& operator--(){
+        if constexpr (isReverse == true){
+            _current = _iList->_pool.link(_current).getNext();
+        }
+        else{
+            _current = _iList->_pool.link(_current).getPrevious();
+        }
+        return *this;
+    }
+
+    IndexIterator operator--(int){
+        auto it = *this;
+        --(*this);
+        return it;
+    }
+
+    IndexIterator operator++(int){
+        auto it = *this;
+        ++(*this);
+        return it;
+    }
+
+    // O(1) while the list is ordered, walks the links otherwise
+    IndexIterator operator+(size_t advance) const{
+        if(_iList->isOrdered()){
+            return IndexIterator(_iList, _iList->orderedAdvance(_current, advance, !isReverse));
+        }
+        auto it = *this;
+        for(; advance > 0; --advance){
+            ++it;
+        }
+        return it;
+    }
+
+    IndexIterator operator-(size_t advance) const{
+        if(_iList->isOrdered()){
+            return IndexIterator(_iList, _iList->orderedAdvance(_current, advance, isReverse));
+        }
+        auto it = *this;
+        for(; advance > 0; --advance){
+            --it;
+        }
+        return it;
+    }
+
+    T& operator*(void) const{
+        return _iList->_pool.data(_current);
+    }
+    T* operator->(void) const{
+        return &_iList->_pool.data(_current);
+    }
+
+    index_type getPreviousIndex() const{return _iList->_pool.link(_current).getPrevious();}
+
+    index_type getCurrentIndex() const {return _current;}
+
+    index_type getNextIndex() const {return _iList->_pool.link(_current).getNext();}
+
+
+    private:
+    List* _iList;
+    index_type _current;
+
+    constexpr IndexIterator(List* iList, index_type index) : _iList(iList), _current(index) {}
+    friend List;
+    template <class, bool, class, class>
+    friend class IndexIterator;
+};
+template <class T, class Index = index_t, class List = IndexList<T, InterleavedIndexLayout, Index>>
+using ReverseIndexIterator = IndexIterator<T,true,Index,List>;
+
+template <class T, class Layout, class Index, class Allocator>
+class IndexList{
+
+    public:
+    using value_type        = T;
+    using layout_type       = Layout;
+    using index_type        = Index;
+    using allocator_type    = Allocator;
+    using pool_type         = typename Layout::template pool<T, Index, Allocator>;
+    using iterator                  = IndexIterator<T,false,Index,IndexList>;
+    using reverse_iterator          = ReverseIndexIterator<T,Index,IndexList>;
+    using const_iterator            = IndexIterator<const T,false,Index,const IndexList>;
+    using const_reverse_iterator    = ReverseIndexIterator<const T,Index,const IndexList>;
+    using handle_type               = IndexHandle<Index>;
+
+    IndexList() : IndexList(Allocator()){}
+    // the pool takes its memory from allocator, e.g. an arena through
+    // std::pmr::polymorphic_allocator (see pmr::IndexList)
+    explicit IndexList(const Allocator& allocator) : _pool(allocator){_pool.emplaceLink(0,0);}
+    IndexList(const IndexList& other) = default;
+    // allocator-extended copy and move, used by uses-allocator construction
+    // so a pmr container hands its resource down to the lists it holds
+    IndexList(const IndexList& other, const Allocator& allocator) : _pool(other._pool, allocator){
+        copyState(other);
+    }
+    IndexList(IndexList&& other, const Allocator& allocator) : IndexList(allocator){
+        if(get_allocator() == other.get_allocator()){
+            swap(other);
+        }
+        else{
+            IndexList copy(other, allocator);
+            swap(copy);
+            other.clear();
+        }
+    }
+    // takes the pool of other over, other is left empty with a fresh
+    // sentinel from its allocator. Allocating that one can throw, so the
+    // move is not noexcept and containers of lists copy them when they
+    // grow, as with node based lists that keep their sentinel on the heap.
+    IndexList(IndexList&& other) : IndexList(other.get_allocator()){
+        swap(other);
+    }
+    IndexList& operator = (const IndexList& other) = default;
+    // storage is exchanged when the allocators compare equal and the old
+    // elements are destroyed with other, nothing is allocated then. A
+    // propagating allocator is taken over with the pool and other gets a
+    // fresh sentinel, the elements are copied otherwise.
+    IndexList& operator = (IndexList&& other) noexcept(std::allocator_traits<Allocator>::is_always_equal::value){
+        if(this != &other){
+            if(std::allocator_traits<Allocator>::is_always_equal::value || get_allocator() == other.get_allocator()){
+                swap(other);
+            }
+            else if constexpr(std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value){
+                pool_type sentinel(other.get_allocator());
+                sentinel.emplaceLink(0,0);
+                _pool       = std::move(other._pool);
+                other._pool = std::move(sentinel);
+                swapState(other);
+            }
+            else{
+                IndexList copy(other, get_allocator());
+                swap(copy);
+            }
+            other.clear();
+        }
+        return *this;
+    }
+
+    // exchanges elements, handles and settings. Handles follow their
+    // elements, iterators stay bound to the list object they came from.
+    // Allocators are exchanged only when they propagate on swap.
+    void swap(IndexList& other) noexcept{
+        _pool.swap(other._pool);
+        swapState(other);
+    }
+    friend void swap(IndexList& a, IndexList& b) noexcept{
+        a.swap(b);
+    }
+
+    allocator_type get_allocator() const{
+        return _pool.get_allocator();
+    }
+
+    iterator begin(){
+        return iterator(this,_pool.link(endIndex).getNext());
+    }
+    iterator end(){
+        return iterator(this,endIndex);
+    }
+    reverse_iterator rbegin(){
+        return reverse_iterator(this,_pool.link(endIndex).getPrevious());
+    }
+    reverse_iterator rend(){
+        return reverse_iterator(this,endIndex);
+    }
+
+    // const traversal only reads, lists can be shared by concurrent readers
+    const_iterator begin() const{
+        return const_iterator(this,_pool.link(endIndex).getNext());
+    }
+    const_iterator end() const{
+        return const_iterator(this,endIndex);
+    }
+    const_reverse_iterator rbegin() const{
+        return const_reverse_iterator(this,_pool.link(endIndex).getPrevious());
+    }
+    const_reverse_iterator rend() const{
+        return const_reverse_iterator(this,endIndex);
+    }
+    const_iterator cbegin() const{
+        return begin();
+    }
+    const_iterator cend() const{
+        return end();
+    }
+    const_reverse_iterator crbegin() const{
+        return rbegin();
+    }
+    const_reverse_iterator crend() const{
+        return rend();
+    }
+
+    T& front(){
+        return _pool.data(_pool.link(endIndex).getNext());
+    }
+    const T& front() const{
+        return _pool.data(_pool.link(endIndex).getNext());
+    }
+
+    T& back(){
+        return _pool.data(_pool.link(endIndex).getPrevious());
+    }
+    const T& back() const{
+        return _pool.data(_pool.link(endIndex).getPrevious());
+    }
+
+    void reserve(size_t nSize){
+        checkCapacity(nSize+1);
+        _pool.reserve(nSize+1);
+    }
+
+    iterator insert(iterator it, const T& data){
+        return emplace(it.getCurrentIndex(), data);
+    }
+
+    iterator insert(iterator it, T&& data){
+        return emplace(it.getCurrentIndex(), std::move(data));
+    }
+
+    iterator push_front(const T& data){
+        return emplace(endIndex, data);
+    }
+
+    iterator push_front(T&& data){
+        return emplace(endIndex, std::move(data));
+    }
+
+    iterator push_back(const T& data){
+        return emplace(_pool.link(endIndex).getPrevious(), data);
+    }
+
+    iterator push_back(T&& data){
+        return emplace(_pool.link(endIndex).getPrevious(), std::move(data));
+    }
+
+
+
+
+    template <class... Args>
+    iterator emplace(const iterator& it, Args&&... args){
+        return emplace(it.getCurrentIndex(), std::forward<Args>(args)...);
+    }
+
+    template <class... Args>
+    iterator emplace( Index current, Args&&... args){
+
+        Index currentNext    = _pool.link(current).getNext();
+        Index newIndex       = static_cast<Index>(_pool.size());
+        const bool append    = (currentNext == endIndex);
+
+        if(_eraseListBegin == emptyEraseList){
+            checkCapacity(_pool.size()+1);
+            _pool.emplace_back(current, currentNext, std::forward<Args>(args)...);
+        }
+        else{
+            newIndex                = _eraseListBegin;
+            const Index nextErased  = _pool.link(newIndex).getNext();
+            _pool.assign(newIndex, current, currentNext, std::forward<Args>(args)...);
+            _eraseListBegin         = nextErased;
+
+        }
+
+        _pool.link(currentNext).setPrevious(newIndex);
+        _pool.link(current).setNext(newIndex);
+
+        markLive(newIndex);
+        if(append){
+            appendedSlot(newIndex);
+        }
+        else{
+            positionsChanged();
+        }
+        _size++;
+
+        return iterator(this, newIndex);
+    }
+
+    template <class... Args>
+    iterator emplace_front(Args&&... args){
+        return emplace(endIndex, std::forward<Args>(args)...);
+    }
+
+    template <class... Args>
+    iterator emplace_back(Args&&... args){
+
+        return emplace( _pool.link(endIndex).getPrevious(), std::forward<Args>(args)...);
+    }
+
+    // inserts [first, last) after it, returns iterator to the first inserted element
+    template <class InputIt, class = typename std::iterator_traits<InputIt>::iterator_category>
+    iterator insert(iterator it, InputIt first, InputIt last){
+        using category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr(std::is_base_of_v<std::forward_iterator_tag, category>){
+            return insertRun(it.getCurrentIndex(), static_cast<size_t>(std::distance(first, last)), [&first]() -> decltype(auto){
+                return *first++;
+            });
+        }
+        else{
+            const Index current     = it.getCurrentIndex();
+            const Index currentNext = _pool.link(current).getNext();
+            for(Index position = current; first != last; ++first){
+                position = emplace(position, *first).getCurrentIndex();
+            }
+            return iterator(this, (_pool.link(current).getNext() != currentNext) ? _pool.link(current).getNext() : current);
+        }
+    }
+
+    // data may be an element of this list and the pool grows before the
+    // copies are made, so they are made from a local copy
+    iterator insert(iterator it, size_t count, const T& data){
+        if(count == 0){
+            return it;
+        }
+        const T value(data);
+        return insertRun(it.getCurrentIndex(), count, [&value]() -> const T&{
+            return value;
+        });
+    }
+
+    iterator insert(iterator it, std::initializer_list<T> list){
+        return insert(it, list.begin(), list.end());
+    }
+
+    template <class Range>
+    iterator append_range(Range&& range){
+        return insert(iterator(this, _pool.link(endIndex).getPrevious()), std::begin(range), std::end(range));
+    }
+
+
+    // returns iterator to the element after it. Auto compaction may move
+    // every element, so only the returned iterator stays valid.
+    iterator erase(iterator it){
+        if(it == end()){
+            return it;
+        }
+        const Index current    = it.getCurrentIndex();
+        const Index previous   = _pool.link(current).getPrevious();
+        const Index next       = _pool.link(current).getNext();
+
+        _pool.link(next).setPrevious(previous);
+        _pool.link(previous).setNext(next);
+
+        releaseSlot(current);
+        _size--;
+        if(next == endIndex){
+            trimSkipIndex();
+        }
+        else{
+            positionsChanged();
+        }
+        return iterator(this, compactIfFragmented(next));
+    }
+
+    // erases [first, last), the whole run is unlinked with one pair of link updates
+    iterator erase(iterator first, iterator last){
+        const Index stop = last.getCurrentIndex();
+        Index index      = first.getCurrentIndex();
+        if(index == stop){
+            return last;
+        }
+        const Index previous = _pool.link(index).getPrevious();
+
+        while(index != stop){
+            const Index next = _pool.link(index).getNext();
+            releaseSlot(index);
+            _size--;
+            index = next;
+        }
+
+        _pool.link(previous).setNext(stop);
+        _pool.link(stop).setPrevious(previous);
+
+        if(stop == endIndex){
+            trimSkipIndex();
+        }
+        else{
+            positionsChanged();
+        }
+        return iterator(this, compactIfFragmented(stop));
+    }
+
+    // erases every element matching pred in one pass, consecutive erased
+    // elements are unlinked as a run, returns the number of erased elements
+    template <class Pred>
+    size_t erase_if(Pred pred){
+        const Index oldSize = _size;
+        Index kept          = endIndex;
+        Index index         = _pool.link(endIndex).getNext();
+
+        while(index != endIndex){
+            const Index next = _pool.link(index).getNext();
+            bool matches;
+            try{
+                matches = pred(_pool.data(index));
+            }
+            catch(...){
+                // the run erased so far is unlinked, the rest stays as it was
+                _pool.link(kept).setNext(index);
+                _pool.link(index).setPrevious(kept);
+                if(oldSize != _size){
+                    positionsChanged();
+                }
+                throw;
+            }
+            if(matches){
+                releaseSlot(index);
+                _size--;
+            }
+            else{
+                if(_pool.link(index).getPrevious() != kept){
+                    _pool.link(kept).setNext(index);
+                    _pool.link(index).setPrevious(kept);
+                }
+                kept = index;
+            }
+            index = next;
+        }
+
+        _pool.link(kept).setNext(endIndex);
+        _pool.link(endIndex).setPrevious(kept);
+
+        if(oldSize != _size){
+            positionsChanged();
+            compactIfFragmented();
+        }
+        return oldSize - _size;
+    }
+
+    // calls f on every element in list order, f must not insert or erase.
+    // A second cursor runs distance elements ahead and prefetches the slots
+    // it passes, so on a fragmented pool the payload misses of the next
+    // elements overlap with f instead of stalling every step. An ordered
+    // list is scanned in pool order, the hardware prefetcher covers that.
+    template <class Func>
+    void for_each_prefetched(Func f, size_t distance = 4){
+        forEachPrefetched(*this, f, distance);
+    }
+    template <class Func>
+    void for_each_prefetched(Func f, size_t distance = 4) const{
+        forEachPrefetched(*this, f, distance);
+    }
+
+    template <class Pred>
+    size_t remove_if(Pred pred){
+        return erase_if(pred);
+    }
+
+    size_t remove(const T& value){
+        return erase_if([&value](const T& data){
+            return data == value;
+        });
+    }
+
+    void pop_front(){
+        erase(begin());
+    }
+
+    void pop_back(){
+        erase(iterator(this, _pool.link(endIndex).getPrevious()));
+    }
+
+    // erases all elements and keeps the capacity, the pool is cut back to
+    // the sentinel. O(1) for trivially destructible T, one destroy pass over
+    // the pool otherwise. Handles are invalidated with one pass over the
+    // handle table if any were taken.
+    void clear(){
+        _pool.truncate(endIndex + 1);
+        _pool.link(endIndex).setPrevious(endIndex);
+        _pool.link(endIndex).setNext(endIndex);
+        _eraseListBegin = emptyEraseList;
+        _size           = 0;
+        _liveBits.clear();
+        releaseAllKeys();
+
+        _reorderCursor  = 0;
+        _detachedBelow  = 0;
+        _reorderPlacing = false;
+        _reorderClean   = false;
+        _ordered        = true;
+        _skipIndex.clear();
+    }
+
+    // clear() that also drops the auto-compaction and skip index settings,
+    // the list behaves like a new one but reuses the pool, bitmap and handle
+    // table allocations. Meant for lists rebuilt every frame.
+    void reset_keep_capacity(){
+        clear();
+        _compactThreshold   = 0;
+        _compactMinSlots    = 0;
+        _skipStride         = 0;
+    }
+
+    void resize(size_t newSize){
+        if(_size < newSize){
+            for(size_t i = 0, sizeDiff = newSize - _size ; i < sizeDiff; i++){
+                emplace_back();
+            }
+        }
+        else if(_size > newSize){
+            for(size_t i = 0, sizeDiff = _size - newSize ; i < sizeDiff; i++){
+                pop_back();
+            }
+        }
+
+    }
+
+
+    void shrink_to_fit(){
+        compact();
+        relinkSequential();
+
+        _pool.truncate(_size+1);
+        _pool.shrink_to_fit();
+        if(_slotKeys.size() > _pool.size()){
+            _slotKeys.resize(_pool.size());
+        }
+        _liveBits.resize((_pool.size() + 63) / 64);
+        _liveBits.shrink_to_fit();
+
+        _eraseListBegin = emptyEraseList;
+        _reorderCursor  = 0;
+        _detachedBelow  = 0;
+        _reorderPlacing = false;
+        _ordered        = true;
+        _skipIndex.clear();
+    }
+
+    // moves the elements so slot i holds the i-th element of the list,
+    // iteration becomes a forward scan of the pool. Erased slots end up behind
+    // the elements and on the erase list in ascending order.
+    void reorder(){
+        compact();
+        relinkSequential();
+        threadErasedTail();
+    }
+
+    // stable sort by cmp, the result is laid out in pool order like after
+    // reorder(). Small trivially copyable payloads are sorted by value when
+    // no handles are out, otherwise the slots are sorted and every payload is
+    // moved once.
+    template <class Compare>
+    void sort(Compare cmp){
+        if constexpr(isIndexTriviallyRelocatable<T> && sizeof(T) <= 2 * sizeof(Index)){
+            if(_slotKeys.empty()){
+                std::vector<T> values;
+                values.reserve(_size);
+                for(Index index = _pool.link(endIndex).getNext(); index != endIndex; index = _pool.link(index).getNext()){
+                    values.push_back(_pool.data(index));
+                }
+                std::stable_sort(values.begin(), values.end(), cmp);
+
+                for(Index position = 1; position <= _size; ++position){
+                    new (&_pool.data(position)) T(values[position - 1]);
+                }
+                for(Index index = _size + 1; index < _pool.size(); ++index){
+                    _pool.link(index).setPrevious(index);
+                }
+                markLivePrefix(_size);
+                relinkSequential();
+                threadErasedTail();
+                return;
+            }
+        }
+
+        std::vector<Index> source(_size + 1);
+        Index position = 0;
+        for(Index index = _pool.link(endIndex).getNext(); index != endIndex; index = _pool.link(index).getNext()){
+            source[++position] = index;
+        }
+        std::stable_sort(source.begin() + 1, source.end(), [this, &cmp](Index left, Index right){
+            return cmp(_pool.data(left), _pool.data(right));
+        });
+        placeSlots(source);
+        relinkSequential();
+        threadErasedTail();
+    }
+
+    void sort(){
+        sort(std::less<T>());
+    }
+
+    // incremental reorder(), places at most maxNodes elements (or sweeps at
+    // most maxNodes slots) per call and returns true once the pool is in list
+    // order. The list can be modified between calls, elements inserted in
+    // front of the already placed ones stay where they are until the next
+    // run. While it runs erased slots are kept off the erase list so inserts
+    // take fresh slots, they are threaded back by a final sweep over the pool.
+    bool reorderStep(size_t maxNodes){
+        if(_reorderCursor == 0){
+            _reorderCursor  = 1;
+            _reorderPlacing = true;
+            _detachedBelow  = static_cast<Index>(maxPoolSize);
+            _eraseListBegin = emptyEraseList;
+        }
+
+        for(; maxNodes > 0; --maxNodes){
+            if(_reorderPlacing){
+                // slots below the cursor hold the front of the list, step
+                // back over ones erased since they were placed
+                while(_reorderCursor > 1 && isIndexErased(_reorderCursor - 1)){
+                    --_reorderCursor;
+                }
+                const Index source = _pool.link(_reorderCursor - 1).getNext();
+                if(source == endIndex){
+                    _reorderPlacing = false;
+                    _detachedBelow  = static_cast<Index>(_pool.size());
+                    _reorderClean   = true;
+                    continue;
+                }
+                if(source != _reorderCursor){
+                    _ordered = false;
+                    _skipIndex.clear();
+                    if(isIndexErased(_reorderCursor)){
+                        relocateNode(source, _reorderCursor);
+                    }
+                    else{
+                        swapNodes(source, _reorderCursor);
+                    }
+                }
+                ++_reorderCursor;
+            }
+            else{
+                if(_detachedBelow <= 1){
+                    _reorderCursor  = 0;
+                    _detachedBelow  = 0;
+                    _ordered        = _reorderClean && (_pool.link(endIndex).getNext() == (_size ? endIndex + 1 : endIndex));
+                    return true;
+                }
+                // the sweep also checks whether the list ended up ordered
+                --_detachedBelow;
+                const bool erased = isIndexErased(_detachedBelow);
+                if(_detachedBelow <= _size){
+                    _reorderClean = _reorderClean && !erased && (_pool.link(_detachedBelow).getNext() == ((_detachedBelow == _size) ? endIndex : _detachedBelow + 1));
+                }
+                else{
+                    _reorderClean = _reorderClean && erased;
+                }
+                if(erased){
+                    _pool.link(_detachedBelow).setNext(_eraseListBegin);
+                    _eraseListBegin = _detachedBelow;
+                }
+            }
+        }
+        return false;
+    }
+
+    // true while slot i holds the i-th element, set by reorder(),
+    // shrink_to_fit() and a completed reorderStep() run and kept by appends
+    // into the next slot and by erasing the back. Iterator jumps are O(1)
+    // while it holds.
+    bool isOrdered() const{
+        return _ordered;
+    }
+
+    // keeps the slot of every stride-th element so nth() walks at most
+    // stride - 1 links on lists that are not ordered, 0 drops the index.
+    // Entries are filled in lazily, inserting or erasing anywhere but the
+    // back discards them.
+    void setSkipIndex(size_t stride){
+        _skipStride = stride;
+        _skipIndex.clear();
+        if(stride == 0){
+            _skipIndex.shrink_to_fit();
+        }
+    }
+
+    // iterator to the element at position, end() if there is none
+    iterator nth(size_t position){
+        if(position >= _size){
+            return end();
+        }
+        if(_ordered){
+            return iterator(this, static_cast<Index>(position + 1));
+        }
+        if(_skipStride != 0){
+            const size_t block = position / _skipStride;
+            if(_skipIndex.empty()){
+                _skipIndex.push_back(_pool.link(endIndex).getNext());
+            }
+            while(_skipIndex.size() <= block){
+                Index index = _skipIndex.back();
+                for(size_t step = 0; step < _skipStride; ++step){
+                    index = _pool.link(index).getNext();
+                }
+                _skipIndex.push_back(index);
+            }
+            return iterator(this, _skipIndex[block]) + (position - block * _skipStride);
+        }
+        if(position < _size / 2){
+            return begin() + position;
+        }
+        return end() - (_size - position);
+    }
+
+
+    size_t size() const{
+        return _size;
+    }
+    size_t capacity() const{
+        return (_pool.capacity() - 1);
+    }
+
+    // walks the list and the erase list, O(size + free slots)
+    IndexListStats stats() const{
+        IndexListStats result;
+        result.liveNodes    = _size;
+        result.freeSlots    = _pool.size() - 1 - _size;
+        result.capacity     = capacity();
+        result.growthCount  = _pool.growthCount();
+        for(Index index = _eraseListBegin; index != emptyEraseList; index = _pool.link(index).getNext()){
+            ++result.eraseListLength;
+        }
+        if(_size > 1){
+            size_t distance = 0;
+            for(Index index = _pool.link(endIndex).getNext(); _pool.link(index).getNext() != endIndex; index = _pool.link(index).getNext()){
+                const Index next = _pool.link(index).getNext();
+                distance += (next > index) ? next - index : index - next;
+            }
+            result.averageLinkDistance = static_cast<double>(distance) / static_cast<double>(_size - 1);
+        }
+        return result;
+    }
+
+    // runs shrink_to_fit() once an erase leaves more than threshold of the
+    // used slots free, in pools of at least minSlots slots; 0 turns it off.
+    // The compaction invalidates iterators except the one erase() returns,
+    // handles stay valid.
+    void setAutoCompaction(double threshold, size_t minSlots = 1024){
+        _compactThreshold   = threshold;
+        _compactMinSlots    = minSlots;
+    }
+
+    bool empty() const{
+        return (_size == 0);
+    }
+
+
+    T& operator [] (size_t index){
+
+        return _pool.data(index + (!index));
+    }
+    const T& operator [] (size_t index) const{
+        return _pool.data(index + (!index));
+    }
+    template <class Node>
+    bool isNodeErased(const Node& node) const{
+        return (_pool.link(node.getPrevious()).getNext() == node.getNext());
+    }
+    // bit test on the occupancy bitmap, the sentinel counts as erased
+    bool isIndexErased(Index index) const{
+        return !((index / 64 < _liveBits.size()) && ((_liveBits[index / 64] >> (index % 64)) & 1));
+    }
+
+    // first live slot in [from, last), last if there is none. Skips 64
+    // slots per bitmap word.
+    Index findLive(Index from, size_t last = maxPoolSize) const{
+        return findBit(from, last, 0);
+    }
+
+    // first erased slot in [from, last), last if there is none
+    Index findFree(Index from, size_t last = maxPoolSize) const{
+        return findBit(from, last, ~uint64_t(0));
+    }
+
+    // number of live slots in [first, last)
+    size_t countLive(Index first, Index last) const{
+        size_t count = 0;
+        for(size_t word = first / 64; word * 64 < last && word < _liveBits.size(); ++word){
+            uint64_t bits = _liveBits[word];
+            if(word == first / 64){
+                bits &= ~uint64_t(0) << (first % 64);
+            }
+            if((word + 1) * 64 > last){
+                bits &= ~(~uint64_t(0) << (last % 64));
+            }
+            count += indexPopCount(bits);
+        }
+        return count;
+    }
+    // iterator to the element in slot, which has to be live or the sentinel
+    iterator iteratorAt(Index slot){
+        return iterator(this, slot);
+    }
+
+    template <class Node>
+    Index getNodeIndex(const Node& node) const{
+        return _pool.link(node.getPrevious()).getNext();
+    }
+
+    // returns a handle to the element at it, keys are only allocated for
+    // slots a handle was requested for. end() has no element and gets the
+    // default constructed handle, which never resolves.
+    handle_type handle(iterator it){
+        const Index slot = it.getCurrentIndex();
+        if(slot == endIndex){
+            return handle_type{};
+        }
+        if(_slotKeys.size() <= slot){
+            _slotKeys.resize(_pool.size(), noKey);
+        }
+        Index key = _slotKeys[slot];
+        if(key == noKey){
+            if(_freeKeysBegin != noKey){
+                key             = _freeKeysBegin;
+                _freeKeysBegin  = _keys[key].slot;
+            }
+            else{
+                key = static_cast<Index>(_keys.size());
+                _keys.push_back({0, 1});
+            }
+            _keys[key].slot = slot;
+            _slotKeys[slot] = key;
+        }
+        return handle_type{key, _keys[key].generation};
+    }
+
+    bool contains(const handle_type& handle) const{
+        return (handle.key < _keys.size() && _keys[handle.key].generation == handle.generation);
+    }
+
+    iterator find(const handle_type& handle){
+        return iterator(this, contains(handle) ? _keys[handle.key].slot : endIndex);
+    }
+
+    T* get(const handle_type& handle){
+        return contains(handle) ? &_pool.data(_keys[handle.key].slot) : nullptr;
+    }
+
+    void erase(const handle_type& handle){
+        erase(find(handle));
+    }
+
+    pool_type _pool;
+    //private:
+
+    constexpr static Index endIndex        = 0;
+    constexpr static Index emptyEraseList  = 0;
+    Index _eraseListBegin = 0;
+    Index _size = 0;
+    // reorderStep() progress, slots below _detachedBelow are not threaded
+    // onto the erase list when freed. _reorderPlacing tells the placing
+    // phase from the final sweep, a full pool leaves no Index value to mark
+    // it with.
+    Index _reorderCursor = 0;
+    Index _detachedBelow = 0;
+    bool  _reorderClean  = false;
+    bool  _reorderPlacing = false;
+
+    // bit i is set while slot i holds an element
+    std::vector<uint64_t> _liveBits;
+
+    // setAutoCompaction() policy
+    double              _compactThreshold   = 0;
+    size_t              _compactMinSlots    = 0;
+
+    // positional bookkeeping, see isOrdered() and setSkipIndex()
+    bool                _ordered    = true;
+    size_t              _skipStride = 0;
+    std::vector<Index>  _skipIndex;
+
+    friend iterator;
+    friend reverse_iterator;
+    friend const_iterator;
+    friend const_reverse_iterator;
+
+    // largest pool (sentinel included) addressable with Index, the top value
+    // is kept free so it never names a slot
+    constexpr static size_t maxPoolSize      = std::numeric_limits<Index>::max();
+
+    private:
+
+    // links count nodes built from source() after current with a single splice,
+    // erased slots are reused first and the rest is appended to the pool in one run
+    template <class Source>
+    iterator insertRun(Index current, size_t count, Source&& source){
+        if(count == 0){
+            return iterator(this, current);
+        }
+        if(_pool.size() + count > maxPoolSize){
+            size_t reusable = 0;
+            for(Index index = _eraseListBegin; index != emptyEraseList && reusable < count; index = _pool.link(index).getNext()){
+                ++reusable;
+            }
+            checkCapacity(_pool.size() + count - reusable);
+        }
+
+        const Index currentNext = _pool.link(current).getNext();
+        const bool append       = (currentNext == endIndex);
+        Index previous          = current;
+        if(!append){
+            positionsChanged();
+        }
+
+        try{
+            for(; count > 0 && _eraseListBegin != emptyEraseList; --count){
+                const Index newIndex    = _eraseListBegin;
+                const Index nextErased  = _pool.link(newIndex).getNext();
+                _pool.assign(newIndex, previous, currentNext, source());
+                _eraseListBegin         = nextErased;
+                _pool.link(previous).setNext(newIndex);
+                previous = newIndex;
+                markLive(newIndex);
+                if(append){
+                    appendedSlot(newIndex);
+                }
+                _size++;
+            }
+
+            if(count > 0){
+                const size_t poolSize = _pool.size();
+                _pool.grow(count);
+                _pool.link(previous).setNext(static_cast<Index>(poolSize));
+                for(size_t index = poolSize; index < poolSize + count; ++index){
+                    _pool.emplace_back(previous, static_cast<Index>(index + 1), source());
+                    previous = static_cast<Index>(index);
+                    markLive(previous);
+                    if(append){
+                        appendedSlot(previous);
+                    }
+                    _size++;
+                }
+            }
+        }
+        catch(...){
+            // keep what was inserted so far linked in
+            _pool.link(previous).setNext(currentNext);
+            _pool.link(currentNext).setPrevious(previous);
+            throw;
+        }
+
+        _pool.link(previous).setNext(currentNext);
+        _pool.link(currentNext).setPrevious(previous);
+
+        return iterator(this, _pool.link(current).getNext());
+    }
+
+    void markLive(Index index){
+        const size_t word = index / 64;
+        if(word >= _liveBits.size()){
+            _liveBits.resize(word + 1, 0);
+        }
+        _liveBits[word] |= uint64_t(1) << (index % 64);
+    }
+
+    void markFree(Index index){
+        _liveBits[index / 64] &= ~(uint64_t(1) << (index % 64));
+    }
+
+    // marks slots 1..count live and every other slot erased
+    void markLivePrefix(size_t count){
+        const size_t end = count + 1;
+        for(size_t word = 0; word < _liveBits.size(); ++word){
+            const size_t first = word * 64;
+            if(end >= first + 64){
+                _liveBits[word] = ~uint64_t(0);
+            }
+            else if(end > first){
+                _liveBits[word] = (uint64_t(1) << (end - first)) - 1;
+            }
+            else{
+                _liveBits[word] = 0;
+            }
+        }
+        if(!_liveBits.empty()){
+            _liveBits[0] &= ~uint64_t(1);
+        }
+    }
+
+    // first slot in [from, last) whose bit differs from flip, skipping whole
+    // words that hold none, last is clamped to the pool size
+    Index findBit(Index from, size_t last, uint64_t flip) const{
+        const size_t poolEnd = std::min(last, _pool.size());
+        if(from >= poolEnd){
+            return static_cast<Index>(poolEnd);
+        }
+        size_t word     = from / 64;
+        uint64_t bits   = ((word < _liveBits.size()) ? (_liveBits[word] ^ flip) : flip) & (~uint64_t(0) << (from % 64));
+        while(bits == 0){
+            if(++word * 64 >= poolEnd){
+                return static_cast<Index>(poolEnd);
+            }
+            bits = (word < _liveBits.size()) ? (_liveBits[word] ^ flip) : flip;
+        }
+        return static_cast<Index>(std::min(poolEnd, word * 64 + indexCountTrailingZeros(bits)));
+    }
+
+    // slot reached by stepping count links from index on an ordered list,
+    // the sentinel sits between the back and the front like in the ring
+    Index orderedAdvance(Index index, size_t count, bool forward) const{
+        const size_t ring = static_cast<size_t>(_size) + 1;
+        count %= ring;
+        return static_cast<Index>(forward ? (index + count) % ring : (index + ring - count) % ring);
+    }
+
+    // for_each_prefetched() for both constness
+    template <class Self, class Func>
+    static void forEachPrefetched(Self& list, Func& f, size_t distance){
+        if(list._ordered){
+            for(Index index = endIndex + 1; index <= list._size; ++index){
+                f(list._pool.data(index));
+            }
+            return;
+        }
+        if(distance == 0){
+            for(Index index = list._pool.link(endIndex).getNext(); index != endIndex; index = list._pool.link(index).getNext()){
+                f(list._pool.data(index));
+            }
+            return;
+        }
+        Index ahead = list._pool.link(endIndex).getNext();
+        for(size_t step = 1; step < distance && ahead != endIndex; ++step){
+            list.prefetchSlot(ahead);
+            ahead = list._pool.link(ahead).getNext();
+        }
+        if(ahead != endIndex){
+            list.prefetchSlot(ahead);
+        }
+        // the link of ahead is read one call of f after its prefetch
+        for(Index index = list._pool.link(endIndex).getNext(); index != endIndex; index = list._pool.link(index).getNext()){
+            if(ahead != endIndex){
+                ahead = list._pool.link(ahead).getNext();
+                if(ahead != endIndex){
+                    list.prefetchSlot(ahead);
+                }
+            }
+            f(list._pool.data(index));
+        }
+    }
+
+    void prefetchSlot(Index index) const{
+        indexPrefetch(&_pool.link(index), sizeof(IndexLink<Index>));
+        indexPrefetch(&_pool.data(index), sizeof(T));
+    }
+
+    // a node was linked in at the back
+    void appendedSlot(Index index){
+        if(index != _size + 1){
+            _ordered        = false;
+            _reorderClean   = false;
+        }
+    }
+
+    // elements moved to other positions or slots
+    void positionsChanged(){
+        _ordered        = false;
+        _reorderClean   = false;
+        _skipIndex.clear();
+    }
+
+    // drops skip entries past the back after erasing there
+    void trimSkipIndex(){
+        while(!_skipIndex.empty() && (_skipIndex.size() - 1) * _skipStride >= _size){
+            _skipIndex.pop_back();
+        }
+    }
+
+    struct KeySlot{
+        Index       slot;
+        typename handle_type::generation_type generation;
+    };
+
+    constexpr static Index noKey = std::numeric_limits<Index>::max();
+
+    std::vector<KeySlot>    _keys;
+    std::vector<Index>      _slotKeys;
+    Index                   _freeKeysBegin = noKey;
+
+    // everything but the pool, shared by the allocator-extended copy and swap
+    void copyState(const IndexList& other){
+        _eraseListBegin     = other._eraseListBegin;
+        _size               = other._size;
+        _reorderCursor      = other._reorderCursor;
+        _detachedBelow      = other._detachedBelow;
+        _reorderClean       = other._reorderClean;
+        _reorderPlacing     = other._reorderPlacing;
+        _liveBits           = other._liveBits;
+        _compactThreshold   = other._compactThreshold;
+        _compactMinSlots    = other._compactMinSlots;
+        _ordered            = other._ordered;
+        _skipStride         = other._skipStride;
+        _skipIndex          = other._skipIndex;
+        _keys               = other._keys;
+        _slotKeys           = other._slotKeys;
+        _freeKeysBegin      = other._freeKeysBegin;
+    }
+    void swapState(IndexList& other) noexcept{
+        std::swap(_eraseListBegin, other._eraseListBegin);
+        std::swap(_size, other._size);
+        std::swap(_reorderCursor, other._reorderCursor);
+        std::swap(_detachedBelow, other._detachedBelow);
+        std::swap(_reorderClean, other._reorderClean);
+        std::swap(_reorderPlacing, other._reorderPlacing);
+        _liveBits.swap(other._liveBits);
+        std::swap(_compactThreshold, other._compactThreshold);
+        std::swap(_compactMinSlots, other._compactMinSlots);
+        std::swap(_ordered, other._ordered);
+        std::swap(_skipStride, other._skipStride);
+        _skipIndex.swap(other._skipIndex);
+        _keys.swap(other._keys);
+        _slotKeys.swap(other._slotKeys);
+        std::swap(_freeKeysBegin, other._freeKeysBegin);
+    }
+
+    // invalidates handles of a slot that is being freed
+    void releaseKey(Index slot){
+        if(slot < _slotKeys.size() && _slotKeys[slot] != noKey){
+            const Index key     = _slotKeys[slot];
+            _keys[key].generation++;
+            _keys[key].slot     = _freeKeysBegin;
+            _freeKeysBegin      = key;
+            _slotKeys[slot]     = noKey;
+        }
+    }
+
+    // invalidates all handles and puts every key onto the free key list
+    void releaseAllKeys(){
+        if(_keys.empty()){
+            return;
+        }
+        for(size_t key = 0; key < _keys.size(); ++key){
+            _keys[key].generation++;
+            _keys[key].slot = static_cast<Index>(key + 1);
+        }
+        _keys.back().slot   = noKey;
+        _freeKeysBegin      = 0;
+        _slotKeys.clear();
+    }
+
+    // keeps handles pointing at a payload moved from one slot to another
+    void moveKey(Index from, Index to){
+        if(from < _slotKeys.size()){
+            const Index key = _slotKeys[from];
+            if(to >= _slotKeys.size()){
+                _slotKeys.resize(_pool.size(), noKey);
+            }
+            _slotKeys[to]   = key;
+            _slotKeys[from] = noKey;
+            if(key != noKey){
+                _keys[key].slot = to;
+            }
+        }
+    }
+
+    // detaches the handle key of a slot, noKey if it has none
+    Index takeKey(Index slot){
+        if(slot >= _slotKeys.size()){
+            return noKey;
+        }
+        const Index key = _slotKeys[slot];
+        _slotKeys[slot] = noKey;
+        return key;
+    }
+
+    void putKey(Index slot, Index key){
+        if(key == noKey){
+            return;
+        }
+        if(slot >= _slotKeys.size()){
+            _slotKeys.resize(_pool.size(), noKey);
+        }
+        _slotKeys[slot] = key;
+        _keys[key].slot = slot;
+    }
+
+    // destroys the payload of a slot and threads it onto the erase list,
+    // slots reorderStep() has not swept yet are only marked erased
+    void releaseSlot(Index index){
+        _pool.vacate(index);
+        releaseKey(index);
+        markFree(index);
+        _pool.link(index).setPrevious(index);
+        if(index >= _detachedBelow){
+            _pool.link(index).setNext(_eraseListBegin);
+            _eraseListBegin = index;
+        }
+    }
+
+    // setAutoCompaction() check after an erase, returns the slot the
+    // element in slot keep ends up in
+    Index compactIfFragmented(Index keep = endIndex){
+        if(_compactThreshold > 0 && _pool.size() >= _compactMinSlots && _pool.size() - 1 - _size > _compactThreshold * (_pool.size() - 1)){
+            Index position = 0;
+            if(keep != endIndex){
+                for(Index index = _pool.link(endIndex).getNext(); index != keep; index = _pool.link(index).getNext()){
+                    ++position;
+                }
+            }
+            shrink_to_fit();
+            return (keep != endIndex) ? position + 1 : endIndex;
+        }
+        return keep;
+    }
+
+    void checkCapacity(size_t poolSize) const{
+        if(poolSize > maxPoolSize){
+            throw std::length_error("IndexList: index type too narrow for requested size");
+        }
+    }
+
+    // moves the element at list position i into slot i and marks the slots
+    // behind the elements erased, links are left for relinkSequential().
+    // The slot of every position is collected first, then each payload is
+    // moved once: chains starting at an erased slot need no temporary, the
+    // remaining cycles park one payload aside. Lists already in pool order
+    // are detected with a sequential scan, with trivially relocatable
+    // payloads those are compacted run by run.
+    void compact(){
+        const Index poolEnd = static_cast<Index>(_pool.size());
+
+        std::vector<Index> source(_size + 1);
+        bool ascending  = true;
+        Index position  = 0;
+        for(Index index = findLive(1); index < poolEnd; index = findLive(index + 1)){
+            ascending           = ascending && (_pool.link(source[position]).getNext() == index);
+            source[++position]  = index;
+        }
+
+        if(ascending){
+            if constexpr(isIndexTriviallyRelocatable<T>){
+                compactRuns();
+                markLivePrefix(_size);
+                return;
+            }
+        }
+        else{
+            for(position = 1; position <= _size; ++position){
+                source[position] = _pool.link(source[position - 1]).getNext();
+            }
+        }
+        placeSlots(source);
+    }
+
+    // moves the payload of slot source[i] into slot i for every position i,
+    // see compact()
+    void placeSlots(std::vector<Index>& source){
+        const Index poolEnd = static_cast<Index>(_pool.size());
+
+        // the bitmap is not touched below, isIndexErased() still tells which
+        // slots were free when we started
+        for(Index position = 1; position <= _size; ++position){
+            if(source[position] == position || !isIndexErased(position)){
+                continue;
+            }
+            Index target = position;
+            while(true){
+                const Index from    = source[target];
+                source[target]      = target;
+                _pool.moveData(from, target);
+                moveKey(from, target);
+                if(from > _size){
+                    break;
+                }
+                target = from;
+            }
+        }
+
+        for(Index position = 1; position <= _size; ++position){
+            if(source[position] == position){
+                continue;
+            }
+            T parked(std::move(_pool.data(position)));
+            _pool.vacate(position);
+            const Index parkedKey = takeKey(position);
+
+            Index target = position;
+            while(true){
+                const Index from    = source[target];
+                source[target]      = target;
+                if(from == position){
+                    _pool.assign(target, endIndex, endIndex, std::move(parked));
+                    putKey(target, parkedKey);
+                    break;
+                }
+                _pool.moveData(from, target);
+                moveKey(from, target);
+                target = from;
+            }
+        }
+
+        for(Index index = _size + 1; index < poolEnd; ++index){
+            _pool.link(index).setPrevious(index);
+        }
+        markLivePrefix(_size);
+    }
+
+    // compact() for lists in pool order, live runs are moved with memmove
+    void compactRuns(){
+        const Index poolEnd = static_cast<Index>(_pool.size());
+
+        Index write = 1;
+        Index read  = 1;
+        while(read < poolEnd){
+            read                = findLive(read);
+            const Index runEnd  = (read < poolEnd) ? findFree(read) : poolEnd;
+            if(read != write && runEnd != read){
+                _pool.moveRange(read, write, runEnd - read);
+                for(Index index = read; index < runEnd; ++index){
+                    moveKey(index, index - (read - write));
+                }
+            }
+            write   += runEnd - read;
+            read    = runEnd;
+        }
+        for(; write < poolEnd; ++write){
+            _pool.link(write).setPrevious(write);
+        }
+    }
+
+    // moves a live node into the erased slot to, from is left erased
+    void relocateNode(Index from, Index to){
+        const Index previous    = _pool.link(from).getPrevious();
+        const Index next        = _pool.link(from).getNext();
+
+        _pool.moveData(from, to);
+        moveKey(from, to);
+        _pool.link(to).setPrevious(previous);
+        _pool.link(to).setNext(next);
+        _pool.link(previous).setNext(to);
+        _pool.link(next).setPrevious(to);
+        _pool.link(from).setPrevious(from);
+        markLive(to);
+        markFree(from);
+    }
+
+    // exchanges the slots of two live nodes, they may be neighbours
+    void swapNodes(Index a, Index b){
+        T parked(std::move(_pool.data(a)));
+        _pool.vacate(a);
+        _pool.moveData(b, a);
+        _pool.assign(b, _pool.link(b).getPrevious(), _pool.link(b).getNext(), std::move(parked));
+        const Index parkedKey = takeKey(a);
+        moveKey(b, a);
+        putKey(b, parkedKey);
+
+        auto swapped = [a, b](Index index){
+            return (index == a) ? b : ((index == b) ? a : index);
+        };
+        const IndexLink<Index> linkA = _pool.link(a);
+        const IndexLink<Index> linkB = _pool.link(b);
+        _pool.link(a).setPrevious(swapped(linkB.getPrevious()));
+        _pool.link(a).setNext(swapped(linkB.getNext()));
+        _pool.link(b).setPrevious(swapped(linkA.getPrevious()));
+        _pool.link(b).setNext(swapped(linkA.getNext()));
+        _pool.link(_pool.link(a).getPrevious()).setNext(a);
+        _pool.link(_pool.link(a).getNext()).setPrevious(a);
+        _pool.link(_pool.link(b).getPrevious()).setNext(b);
+        _pool.link(_pool.link(b).getNext()).setPrevious(b);
+    }
+
+    // puts the slots behind the elements onto the erase list in ascending
+    // order, used after compact() and relinkSequential()
+    void threadErasedTail(){
+        _eraseListBegin = emptyEraseList;
+        for(Index index = static_cast<Index>(_pool.size() - 1); index > _size; --index){
+            _pool.link(index).setNext(_eraseListBegin);
+            _pool.link(index).setPrevious(index);
+            _eraseListBegin = index;
+        }
+        _reorderCursor  = 0;
+        _detachedBelow  = 0;
+        _reorderPlacing = false;
+        _ordered        = true;
+        _skipIndex.clear();
+    }
+
+    // links the first _size slots in pool order, used after compact()
+    void relinkSequential(){
+        for(Index index = 1; index <= _size; ++index){
+            _pool.link(index).setNext(index + 1);
+            _pool.link(index).setPrevious(index - 1);
+        }
+        _pool.link(endIndex).setPrevious(_size);
+        _pool.link(endIndex).setNext(_size ? endIndex + 1 : endIndex);
+        _pool.link(_size).setNext(endIndex);
+    }
+};
+
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+
+// IndexList with its pool on a std::pmr::memory_resource, for example a
+// monotonic_buffer_resource released as a whole after each frame
+namespace pmr{
+    template<class T, class Layout = InterleavedIndexLayout, class Index = index_t>
+    using IndexList = ::IndexList<T, Layout, Index, std::pmr::polymorphic_allocator<T>>;
+}
+#endif
+
+#endif // INDEXLIST_H
@@ -0,0 +1,346 @@
+#ifndef INDEXSNAPSHOT_H
+#define INDEXSNAPSHOT_H
+
+#include "indexlist.h"
+
+#include <istream>
+#include <ostream>
+
+// Binary snapshot of an IndexList with trivially copyable payload: this
+// header followed by the pool as an array of IndexNode<T, Index>, slot 0
+// first, whatever layout the list uses. Native byte order; handles and a
+// running reorderStep() are not stored, slots the latter held back are
+// reclaimed by the next reorder() or shrink_to_fit().
+struct IndexSnapshotHeader{
+    char        magic[8];
+    uint32_t    version;
+    uint32_t    flags;
+    uint32_t    indexSize;
+    uint32_t    nodeSize;
+    uint64_t    payloadSize;
+    // slots, sentinel included
+    uint64_t    poolSize;
+    uint64_t    eraseListBegin;
+    uint64_t    size;
+    uint64_t    reserved;
+
+    constexpr static char       signature[8]    = {'I', 'D', 'X', 'L', 'I', 'S', 'T', '\0'};
+    constexpr static uint32_t   currentVersion  = 1;
+    constexpr static uint32_t   orderedFlag     = 1;
+};
+static_assert(sizeof(IndexSnapshotHeader) == 64, "snapshot header has to keep the nodes 64 byte aligned");
+
+// checks that header describes a snapshot of IndexNode<T, Index>, throws
+// std::runtime_error otherwise
+template<class T, class Index>
+void checkIndexSnapshotHeader(const IndexSnapshotHeader& header){
+    if(memcmp(header.magic, IndexSnapshotHeader::signature, sizeof(header.magic)) != 0 || header.version != IndexSnapshotHeader::currentVersion){
+        throw std::runtime_error("IndexSnapshot: not an IndexList snapshot");
+    }
+    if(header.indexSize != sizeof(Index) || header.nodeSize != sizeof(IndexNode<T, Index>) || header.payloadSize != sizeof(T)){
+        throw std::runtime_error("IndexSnapshot: element or index type does not match");
+    }
+    if(header.poolSize == 0 || header.poolSize > std::numeric_limits<Index>::max() || header.size >= header.poolSize || header.eraseListBegin >= header.poolSize){
+        throw std::runtime_error("IndexSnapshot: corrupt header");
+    }
+}
+
+// checkIndexSnapshotHeader() plus a check that the nodes fit into bytes,
+// divides so a huge poolSize cannot wrap the size around
+template<class T, class Index>
+void checkIndexSnapshot(const IndexSnapshotHeader& header, size_t bytes){
+    checkIndexSnapshotHeader<T, Index>(header);
+    if(bytes < sizeof(IndexSnapshotHeader) || (bytes - sizeof(IndexSnapshotHeader)) / sizeof(IndexNode<T, Index>) < header.poolSize){
+        throw std::runtime_error("IndexSnapshot: snapshot is truncated");
+    }
+}
+
+// checks the links of the poolSize nodes seen through link(slot) before
+// anything follows them: every link stays inside the pool, the list is a
+// ring of exactly size live slots through the sentinel, the erase list
+// only holds erased slots and a list flagged ordered has its i-th element
+// in slot i. One pass over the pool and one over the list, throws
+// std::runtime_error on the first broken link.
+template<class Index, class Link>
+void checkIndexSnapshotLinks(const IndexSnapshotHeader& header, Link link){
+    const auto fail = [](){
+        throw std::runtime_error("IndexSnapshot: corrupt links");
+    };
+    const bool ordered = (header.flags & IndexSnapshotHeader::orderedFlag) != 0;
+    size_t live = 0;
+    for(size_t slot = 0; slot < header.poolSize; ++slot){
+        const auto& node = link(static_cast<Index>(slot));
+        if(node.getPrevious() >= header.poolSize || node.getNext() >= header.poolSize){
+            fail();
+        }
+        live += (slot != 0 && node.getPrevious() != slot);
+    }
+    if(live != header.size){
+        fail();
+    }
+
+    // a slot seen twice would need two predecessors, so checking each back
+    // link is enough to rule out cycles that miss the sentinel
+    Index previous = 0;
+    for(size_t count = 0; count < header.size; ++count){
+        const Index current = link(previous).getNext();
+        if(current == 0 || link(current).getPrevious() != previous || (ordered && current != count + 1)){
+            fail();
+        }
+        previous = current;
+    }
+    if(link(previous).getNext() != 0 || link(0).getPrevious() != previous){
+        fail();
+    }
+
+    size_t erased = 0;
+    for(Index slot = static_cast<Index>(header.eraseListBegin); slot != 0; slot = link(slot).getNext()){
+        if(link(slot).getPrevious() != slot || ++erased > header.poolSize - 1 - header.size){
+            fail();
+        }
+    }
+}
+
+// writes list to out, nodes are gathered in blocks of 1024 so other layouts
+// are converted on the way
+template<class List>
+void writeIndexSnapshot(const List& list, std::ostream& out){
+    using T         = typename List::value_type;
+    using Index     = typename List::index_type;
+    using node_type = IndexNode<T, Index>;
+    static_assert(std::is_trivially_copyable_v<T>, "snapshots need trivially copyable payload");
+
+    const size_t poolSize = list._pool.size();
+    IndexSnapshotHeader header{};
+    memcpy(header.magic, IndexSnapshotHeader::signature, sizeof(header.magic));
+    header.version          = IndexSnapshotHeader::currentVersion;
+    header.flags            = list.isOrdered() ? IndexSnapshotHeader::orderedFlag : 0;
+    header.indexSize        = sizeof(Index);
+    header.nodeSize         = sizeof(node_type);
+    header.payloadSize      = sizeof(T);
+    header.poolSize         = poolSize;
+    header.eraseListBegin   = list._eraseListBegin;
+    header.size             = list.size();
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::vector<node_type> block(std::min<size_t>(poolSize, 1024));
+    for(size_t first = 0; first < poolSize; first += block.size()){
+        const size_t count = std::min(block.size(), poolSize - first);
+        for(size_t index = 0; index < count; ++index){
+            const Index slot = static_cast<Index>(first + index);
+            node_type& node  = block[index];
+            node.setPrevious(list._pool.link(slot).getPrevious());
+            node.setNext(list._pool.link(slot).getNext());
+            if(list._pool.hasData(slot)){
+                memcpy(static_cast<void*>(&node.getData()), &list._pool.data(slot), sizeof(T));
+            }
+            else{
+                memset(static_cast<void*>(&node.getData()), 0, sizeof(T));
+            }
+        }
+        out.write(reinterpret_cast<const char*>(block.data()), count * sizeof(node_type));
+    }
+    if(!out){
+        throw std::runtime_error("IndexSnapshot: write failed");
+    }
+}
+
+namespace indexsnapshot_detail{
+    // fills a fresh list with the poolSize nodes copied out by
+    // read(destination, count), slot 0 replaces the sentinel. Interleaved
+    // pools are read straight into their node array.
+    template<class List, class Read>
+    List build(const IndexSnapshotHeader& header, Read read){
+        using T         = typename List::value_type;
+        using Index     = typename List::index_type;
+        using node_type = IndexNode<T, Index>;
+
+        List list;
+        node_type sentinel;
+        read(&sentinel, 1);
+        list._pool.link(List::endIndex).setPrevious(sentinel.getPrevious());
+        list._pool.link(List::endIndex).setNext(sentinel.getNext());
+
+        if constexpr(std::is_same_v<typename List::pool_type, IndexNodePool<T, Index, typename List::allocator_type>>){
+            read(list._pool.appendRaw(header.poolSize - 1), header.poolSize - 1);
+        }
+        else{
+            list._pool.reserve(header.poolSize);
+            std::vector<node_type> block(std::min<size_t>(header.poolSize, 1024));
+            for(size_t first = 1; first < header.poolSize; first += block.size()){
+                const size_t count = std::min(block.size(), header.poolSize - first);
+                read(block.data(), count);
+                for(size_t index = 0; index < count; ++index){
+                    list._pool.emplace_back(block[index].getPrevious(), block[index].getNext(), block[index].getData());
+                }
+            }
+        }
+
+        checkIndexSnapshotLinks<Index>(header, [&list](Index slot) -> const IndexLink<Index>&{
+            return list._pool.link(slot);
+        });
+
+        list._liveBits.assign((header.poolSize + 63) / 64, 0);
+        for(Index slot = 1; slot < header.poolSize; ++slot){
+            if(list._pool.link(slot).getPrevious() != slot){
+                list._liveBits[slot / 64] |= uint64_t(1) << (slot % 64);
+            }
+        }
+        list._eraseListBegin    = static_cast<Index>(header.eraseListBegin);
+        list._size              = static_cast<Index>(header.size);
+        list._ordered           = (header.flags & IndexSnapshotHeader::orderedFlag) != 0;
+        return list;
+    }
+}
+
+// rebuilds a list from a snapshot in memory, erased slots stay where they
+// were so the list iterates in the same pool order as the saved one
+template<class List>
+List readIndexSnapshot(const void* data, size_t bytes){
+    using T         = typename List::value_type;
+    using Index     = typename List::index_type;
+    using node_type = IndexNode<T, Index>;
+    static_assert(std::is_trivially_copyable_v<T>, "snapshots need trivially copyable payload");
+
+    IndexSnapshotHeader header;
+    if(bytes < sizeof(header)){
+        throw std::runtime_error("IndexSnapshot: snapshot is truncated");
+    }
+    memcpy(&header, data, sizeof(header));
+    checkIndexSnapshot<T, Index>(header, bytes);
+
+    const char* cursor = static_cast<const char*>(data) + sizeof(header);
+    return indexsnapshot_detail::build<List>(header, [&cursor](node_type* destination, size_t count){
+        memcpy(static_cast<void*>(destination), cursor, count * sizeof(node_type));
+        cursor += count * sizeof(node_type);
+    });
+}
+
+template<class List>
+List readIndexSnapshot(std::istream& in){
+    using T         = typename List::value_type;
+    using Index     = typename List::index_type;
+    using node_type = IndexNode<T, Index>;
+    static_assert(std::is_trivially_copyable_v<T>, "snapshots need trivially copyable payload");
+
+    IndexSnapshotHeader header;
+    if(!in.read(reinterpret_cast<char*>(&header), sizeof(header))){
+        throw std::runtime_error("IndexSnapshot: snapshot is truncated");
+    }
+    // seekable streams are checked against their length before the pool is
+    // allocated, a short stream of another kind fails the reads
+    const std::istream::pos_type nodes = in.tellg();
+    if(nodes != std::istream::pos_type(-1) && in.seekg(0, std::ios::end)){
+        const std::istream::pos_type end = in.tellg();
+        in.seekg(nodes);
+        checkIndexSnapshot<T, Index>(header, sizeof(header) + static_cast<size_t>(end - nodes));
+    }
+    else{
+        in.clear();
+        checkIndexSnapshotHeader<T, Index>(header);
+    }
+
+    return indexsnapshot_detail::build<List>(header, [&in](node_type* destination, size_t count){
+        if(!in.read(reinterpret_cast<char*>(destination), count * sizeof(node_type))){
+            throw std::runtime_error("IndexSnapshot: snapshot is truncated");
+        }
+    });
+}
+
+// Nodes of a snapshot as seen by IndexIterator
+template<class T, class Index>
+struct IndexSnapshotPool{
+    const IndexNode<T, Index>* _nodes = nullptr;
+
+    const IndexLink<Index>& link(Index index) const {return _nodes[index];}
+    const T& data(Index index) const {return _nodes[index].getData();}
+};
+
+// Read-only list over a snapshot in place, for example a memory mapped
+// file. Nothing is copied, data has to stay valid and be aligned for
+// IndexNode<T, Index> (a mapping is). The links and the ordered flag are
+// checked on construction, which reads every node; checkLinks = false skips
+// that for snapshots from a trusted source and leaves a mapping to be paged
+// in as it is iterated.
+template<class T, class Index = index_t>
+class IndexListView{
+
+    public:
+    using value_type        = T;
+    using index_type        = Index;
+    using iterator          = IndexIterator<const T,false,Index,const IndexListView>;
+    using reverse_iterator  = IndexIterator<const T,true,Index,const IndexListView>;
+
+    IndexListView(const void* data, size_t bytes, bool checkLinks = true){
+        static_assert(std::is_trivially_copyable_v<T>, "snapshots need trivially copyable payload");
+        if(reinterpret_cast<uintptr_t>(data) % alignof(IndexNode<T, Index>) != 0){
+            throw std::runtime_error("IndexSnapshot: view data is not aligned");
+        }
+        IndexSnapshotHeader header;
+        if(bytes < sizeof(header)){
+            throw std::runtime_error("IndexSnapshot: snapshot is truncated");
+        }
+        memcpy(&header, data, sizeof(header));
+        checkIndexSnapshot<T, Index>(header, bytes);
+
+        _pool._nodes    = reinterpret_cast<const IndexNode<T, Index>*>(static_cast<const char*>(data) + sizeof(header));
+        if(checkLinks){
+            checkIndexSnapshotLinks<Index>(header, [this](Index slot) -> const IndexLink<Index>&{
+                return _pool.link(slot);
+            });
+        }
+        _size           = static_cast<Index>(header.size);
+        _ordered        = (header.flags & IndexSnapshotHeader::orderedFlag) != 0;
+    }
+
+    iterator begin() const{
+        return iterator(this,_pool.link(endIndex).getNext());
+    }
+    iterator end() const{
+        return iterator(this,endIndex);
+    }
+    reverse_iterator rbegin() const{
+        return reverse_iterator(this,_pool.link(endIndex).getPrevious());
+    }
+    reverse_iterator rend() const{
+        return reverse_iterator(this,endIndex);
+    }
+
+    const T& front() const{
+        return _pool.data(_pool.link(endIndex).getNext());
+    }
+    const T& back() const{
+        return _pool.data(_pool.link(endIndex).getPrevious());
+    }
+
+    size_t size() const{
+        return _size;
+    }
+    bool empty() const{
+        return (_size == 0);
+    }
+
+    // saved from IndexList::isOrdered(), iterator jumps are O(1) when set
+    bool isOrdered() const{
+        return _ordered;
+    }
+
+    IndexSnapshotPool<T, Index> _pool;
+
+    constexpr static Index endIndex = 0;
+
+    private:
+    Index   _size       = 0;
+    bool    _ordered    = false;
+
+    Index orderedAdvance(Index index, size_t count, bool forward) const{
+        const size_t ring = static_cast<size_t>(_size) + 1;
+        count %= ring;
+        return static_cast<Index>(forward ? (index + count) % ring : (index + ring - count) % ring);
+    }
+
+    friend iterator;
+    friend reverse_iterator;
+};
+
+#endif // INDEXSNAPSHOT_H
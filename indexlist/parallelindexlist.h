@@ -0,0 +1,281 @@
+#ifndef PARALLELINDEXLIST_H
+#define PARALLELINDEXLIST_H
+
+#include "indexlist.h"
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <optional>
+
+// Fixed set of worker threads for the parallel IndexList algorithms. run()
+// hands out task numbers until all are taken and returns once every task is
+// finished, the calling thread works along. The first exception thrown by a
+// task skips the remaining tasks and is rethrown by run().
+// A run() from inside a task of the same pool does not wait for the busy
+// workers, its tasks run one after another on the calling thread. Runs
+// started from other threads at the same time take turns.
+class IndexThreadPool{
+    public:
+
+    explicit IndexThreadPool(size_t threadCount = std::thread::hardware_concurrency()){
+        for(size_t worker = 1; worker < threadCount; ++worker){
+            _workers.emplace_back([this](){
+                workerLoop();
+            });
+        }
+    }
+    IndexThreadPool(const IndexThreadPool&) = delete;
+    IndexThreadPool& operator = (const IndexThreadPool&) = delete;
+    ~IndexThreadPool(){
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            _stop = true;
+        }
+        _wake.notify_all();
+        for(auto& worker : _workers){
+            worker.join();
+        }
+    }
+
+    // threads working on a run, the calling one included
+    size_t size() const{
+        return _workers.size() + 1;
+    }
+
+    void run(size_t taskCount, std::function<void(size_t)> task){
+        if(taskCount == 0){
+            return;
+        }
+        if(currentPool() == this){
+            for(size_t index = 0; index < taskCount; ++index){
+                task(index);
+            }
+            return;
+        }
+
+        std::lock_guard<std::mutex> running(_runLock);
+        CurrentPoolScope scope(this);
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            _task       = std::move(task);
+            _taskCount  = taskCount;
+            _active     = _workers.size();
+            _error      = nullptr;
+            _next.store(0, std::memory_order_relaxed);
+            ++_generation;
+        }
+        _wake.notify_all();
+        work();
+
+        std::unique_lock<std::mutex> lock(_lock);
+        _done.wait(lock, [this](){
+            return (_active == 0);
+        });
+        _task = nullptr;
+        if(_error){
+            std::rethrow_exception(_error);
+        }
+    }
+
+    private:
+    std::vector<std::thread>    _workers;
+    std::mutex                  _runLock;
+    std::mutex                  _lock;
+    std::condition_variable     _wake;
+    std::condition_variable     _done;
+
+    std::function<void(size_t)> _task;
+    std::atomic<size_t>         _next{0};
+    size_t                      _taskCount  = 0;
+    size_t                      _active     = 0;
+    size_t                      _generation = 0;
+    bool                        _stop       = false;
+    std::exception_ptr          _error;
+
+    // pool whose tasks the calling thread is running, if any
+    static const IndexThreadPool*& currentPool(){
+        static thread_local const IndexThreadPool* pool = nullptr;
+        return pool;
+    }
+
+    struct CurrentPoolScope{
+        const IndexThreadPool* previous;
+
+        explicit CurrentPoolScope(const IndexThreadPool* pool) : previous(currentPool()){
+            currentPool() = pool;
+        }
+        ~CurrentPoolScope(){
+            currentPool() = previous;
+        }
+    };
+
+    void work(){
+        for(size_t task = _next.fetch_add(1, std::memory_order_relaxed); task < _taskCount; task = _next.fetch_add(1, std::memory_order_relaxed)){
+            try{
+                _task(task);
+            }
+            catch(...){
+                std::lock_guard<std::mutex> guard(_lock);
+                if(!_error){
+                    _error = std::current_exception();
+                }
+                _next.store(_taskCount, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void workerLoop(){
+        CurrentPoolScope scope(this);
+        size_t seen = 0;
+        while(true){
+            {
+                std::unique_lock<std::mutex> lock(_lock);
+                _wake.wait(lock, [this, seen](){
+                    return (_stop || _generation != seen);
+                });
+                if(_stop){
+                    return;
+                }
+                seen = _generation;
+            }
+            work();
+            {
+                std::lock_guard<std::mutex> guard(_lock);
+                if(--_active == 0){
+                    _done.notify_all();
+                }
+            }
+        }
+    }
+};
+
+// slots (or list positions for the ordered variants) handled by one task
+constexpr size_t parallelIndexGrain = 4096;
+
+// Runs f(slot) for the live slots of the pool, split in chunks of
+// parallelIndexGrain slots. Erased slots are skipped a bitmap word at a time.
+template<class List, class F>
+void parallelForEachSlot(IndexThreadPool& threads, List& list, F f, size_t grain = parallelIndexGrain){
+    using Index = typename List::index_type;
+
+    const size_t poolSize = list._pool.size();
+    threads.run((poolSize + grain - 1) / grain, [&list, &f, poolSize, grain](size_t task){
+        const size_t last = std::min(poolSize, (task + 1) * grain);
+        for(Index index = list.findLive(static_cast<Index>(task * grain), last); index < last; index = list.findLive(index + 1, last)){
+            f(index);
+        }
+    });
+}
+
+// Runs f(first, last, slotAt) on consecutive ranges of list positions,
+// slotAt(position) gives the slot of a position. Ordered lists map
+// positions directly, others from a snapshot of the link order.
+template<class List, class F>
+void parallelForEachPositionRange(IndexThreadPool& threads, List& list, F f, size_t grain = parallelIndexGrain){
+    using Index = typename List::index_type;
+
+    const size_t size       = list.size();
+    const size_t taskCount  = (size + grain - 1) / grain;
+    if(list.isOrdered()){
+        threads.run(taskCount, [&f, size, grain](size_t task){
+            f(task * grain, std::min(size, (task + 1) * grain), [](size_t position){
+                return static_cast<Index>(position + 1);
+            });
+        });
+        return;
+    }
+
+    std::vector<Index> snapshot;
+    snapshot.reserve(size);
+    for(auto it = list.begin(); it != list.end(); ++it){
+        snapshot.push_back(it.getCurrentIndex());
+    }
+    threads.run(taskCount, [&f, &snapshot, size, grain](size_t task){
+        f(task * grain, std::min(size, (task + 1) * grain), [&snapshot](size_t position){
+            return snapshot[position];
+        });
+    });
+}
+
+// f(element) for every element in no particular order
+template<class List, class F>
+void parallelForEach(IndexThreadPool& threads, List& list, F f, size_t grain = parallelIndexGrain){
+    parallelForEachSlot(threads, list, [&list, &f](auto slot){
+        f(list._pool.data(slot));
+    }, grain);
+}
+
+// reduce(init, transform(element)...) in no particular order, reduce has
+// to be associative and commutative
+template<class List, class R, class Reduce, class Transform>
+R parallelTransformReduce(IndexThreadPool& threads, List& list, R init, Reduce reduce, Transform transform, size_t grain = parallelIndexGrain){
+    using Index = typename List::index_type;
+
+    const size_t poolSize = list._pool.size();
+    std::vector<std::optional<R>> partial((poolSize + grain - 1) / grain);
+    threads.run(partial.size(), [&](size_t task){
+        const size_t last = std::min(poolSize, (task + 1) * grain);
+        std::optional<R> result;
+        for(Index index = list.findLive(static_cast<Index>(task * grain), last); index < last; index = list.findLive(index + 1, last)){
+            if(result){
+                result = reduce(std::move(*result), transform(list._pool.data(index)));
+            }
+            else{
+                result.emplace(transform(list._pool.data(index)));
+            }
+        }
+        partial[task] = std::move(result);
+    });
+
+    for(auto& result : partial){
+        if(result){
+            init = reduce(std::move(init), std::move(*result));
+        }
+    }
+    return init;
+}
+
+template<class List, class Pred>
+size_t parallelCountIf(IndexThreadPool& threads, List& list, Pred pred, size_t grain = parallelIndexGrain){
+    return parallelTransformReduce(threads, list, size_t(0), std::plus<size_t>(), [&pred](auto& data) -> size_t{
+        return pred(data) ? 1 : 0;
+    }, grain);
+}
+
+// f(element, position) for every element, each task walks a consecutive
+// range of the list in order
+template<class List, class F>
+void parallelForEachOrdered(IndexThreadPool& threads, List& list, F f, size_t grain = parallelIndexGrain){
+    parallelForEachPositionRange(threads, list, [&list, &f](size_t first, size_t last, auto slotAt){
+        for(size_t position = first; position < last; ++position){
+            f(list._pool.data(slotAt(position)), position);
+        }
+    }, grain);
+}
+
+// parallelTransformReduce() that combines in list order, reduce only has to
+// be associative
+template<class List, class R, class Reduce, class Transform>
+R parallelTransformReduceOrdered(IndexThreadPool& threads, List& list, R init, Reduce reduce, Transform transform, size_t grain = parallelIndexGrain){
+    // one partial per task of parallelForEachPositionRange(), the grain has
+    // to be the same for both
+    std::vector<std::optional<R>> partial((list.size() + grain - 1) / grain);
+    parallelForEachPositionRange(threads, list, [&](size_t first, size_t last, auto slotAt){
+        R result = transform(list._pool.data(slotAt(first)));
+        for(size_t position = first + 1; position < last; ++position){
+            result = reduce(std::move(result), transform(list._pool.data(slotAt(position))));
+        }
+        partial[first / grain].emplace(std::move(result));
+    }, grain);
+
+    for(auto& result : partial){
+        init = reduce(std::move(init), std::move(*result));
+    }
+    return init;
+}
+
+#endif // PARALLELINDEXLIST_H
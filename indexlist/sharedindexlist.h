@@ -0,0 +1,349 @@
+#ifndef SHAREDINDEXLIST_H
+#define SHAREDINDEXLIST_H
+
+#include "indexlist.h"
+
+#include <functional>
+
+template<class T, class Layout = InterleavedIndexLayout, class Index = index_t>
+class SharedIndexList;
+
+// Node pool several SharedIndexLists draw from. The first maxLists slots are
+// the list sentinels, erased slots of all lists share one erase list. Lists
+// have to be destroyed before their pool.
+template<class T, class Layout = InterleavedIndexLayout, class Index = index_t>
+class SharedIndexPool{
+    public:
+    using value_type    = T;
+    using index_type    = Index;
+    using pool_type     = typename Layout::template pool<T, Index>;
+
+    explicit SharedIndexPool(size_t maxLists = 16){
+        checkCapacity(maxLists);
+        for(size_t head = 0; head < maxLists; ++head){
+            _pool.emplaceLink(static_cast<Index>(head), static_cast<Index>(head));
+        }
+        for(size_t head = maxLists; head > 0; --head){
+            _freeHeads.push_back(static_cast<Index>(head - 1));
+        }
+    }
+    SharedIndexPool(const SharedIndexPool&) = delete;
+    SharedIndexPool& operator = (const SharedIndexPool&) = delete;
+
+    void reserve(size_t nSize){
+        checkCapacity(nSize);
+        _pool.reserve(nSize);
+    }
+
+    // slots in use or on the erase list, list sentinels included
+    size_t size() const{
+        return _pool.size();
+    }
+
+    pool_type _pool;
+
+    constexpr static Index emptyEraseList   = 0;
+    Index _eraseListBegin                   = 0;
+
+    // largest pool addressable with Index
+    constexpr static size_t maxPoolSize     = std::numeric_limits<Index>::max();
+
+    private:
+    std::vector<Index> _freeHeads;
+
+    Index acquireHead(){
+        if(_freeHeads.empty()){
+            throw std::length_error("SharedIndexPool: all list heads are in use");
+        }
+        const Index head = _freeHeads.back();
+        _freeHeads.pop_back();
+        return head;
+    }
+
+    void releaseHead(Index head){
+        _pool.link(head).setPrevious(head);
+        _pool.link(head).setNext(head);
+        _freeHeads.push_back(head);
+    }
+
+    template <class... Args>
+    Index emplaceSlot(Index previous, Index next, Args&&... args){
+        if(_eraseListBegin == emptyEraseList){
+            checkCapacity(_pool.size()+1);
+            const Index index = static_cast<Index>(_pool.size());
+            _pool.emplace_back(previous, next, std::forward<Args>(args)...);
+            return index;
+        }
+        const Index index       = _eraseListBegin;
+        const Index nextErased  = _pool.link(index).getNext();
+        _pool.assign(index, previous, next, std::forward<Args>(args)...);
+        _eraseListBegin         = nextErased;
+        return index;
+    }
+
+    // destroys the payload of a slot and threads it onto the erase list
+    void releaseSlot(Index index){
+        _pool.vacate(index);
+        _pool.link(index).setPrevious(index);
+        _pool.link(index).setNext(_eraseListBegin);
+        _eraseListBegin = index;
+    }
+
+    void checkCapacity(size_t poolSize) const{
+        if(poolSize > maxPoolSize){
+            throw std::length_error("SharedIndexPool: index type too narrow for requested size");
+        }
+    }
+
+    friend class SharedIndexList<T, Layout, Index>;
+};
+
+// IndexList drawing its nodes from a SharedIndexPool. Elements move between
+// lists of the same pool by relinking only: splice() and merge() neither
+// allocate nor touch payloads, and iterators stay valid when their element
+// changes lists. The list is headed by its own sentinel slot instead of 0.
+template<class T, class Layout, class Index>
+class SharedIndexList{
+
+    public:
+    using value_type        = T;
+    using layout_type       = Layout;
+    using index_type        = Index;
+    using shared_pool_type  = SharedIndexPool<T, Layout, Index>;
+    using pool_type         = typename shared_pool_type::pool_type;
+    using iterator          = IndexIterator<T,false,Index,SharedIndexList>;
+    using reverse_iterator  = ReverseIndexIterator<T,Index,SharedIndexList>;
+
+    explicit SharedIndexList(shared_pool_type& shared) : _pool(shared._pool), _shared(shared), _head(shared.acquireHead()){}
+    SharedIndexList(const SharedIndexList&) = delete;
+    SharedIndexList& operator = (const SharedIndexList&) = delete;
+    ~SharedIndexList(){
+        clear();
+        _shared.releaseHead(_head);
+    }
+
+    iterator begin(){
+        return iterator(this,_pool.link(_head).getNext());
+    }
+    iterator end(){
+        return iterator(this,_head);
+    }
+    reverse_iterator rbegin(){
+        return reverse_iterator(this,_pool.link(_head).getPrevious());
+    }
+    reverse_iterator rend(){
+        return reverse_iterator(this,_head);
+    }
+
+    T& front(){
+        return _pool.data(_pool.link(_head).getNext());
+    }
+    T& back(){
+        return _pool.data(_pool.link(_head).getPrevious());
+    }
+
+    // inserts after it like IndexList, end() inserts at the front
+    template <class... Args>
+    iterator emplace(const iterator& it, Args&&... args){
+        return emplace(it.getCurrentIndex(), std::forward<Args>(args)...);
+    }
+
+    template <class... Args>
+    iterator emplace(Index current, Args&&... args){
+        const Index currentNext = _pool.link(current).getNext();
+        const Index newIndex    = _shared.emplaceSlot(current, currentNext, std::forward<Args>(args)...);
+
+        _pool.link(currentNext).setPrevious(newIndex);
+        _pool.link(current).setNext(newIndex);
+        _size++;
+
+        return iterator(this, newIndex);
+    }
+
+    template <class... Args>
+    iterator emplace_front(Args&&... args){
+        return emplace(_head, std::forward<Args>(args)...);
+    }
+    template <class... Args>
+    iterator emplace_back(Args&&... args){
+        return emplace(_pool.link(_head).getPrevious(), std::forward<Args>(args)...);
+    }
+
+    iterator insert(iterator it, const T& data){
+        return emplace(it.getCurrentIndex(), data);
+    }
+    iterator insert(iterator it, T&& data){
+        return emplace(it.getCurrentIndex(), std::move(data));
+    }
+    iterator push_front(const T& data){
+        return emplace(_head, data);
+    }
+    iterator push_front(T&& data){
+        return emplace(_head, std::move(data));
+    }
+    iterator push_back(const T& data){
+        return emplace(_pool.link(_head).getPrevious(), data);
+    }
+    iterator push_back(T&& data){
+        return emplace(_pool.link(_head).getPrevious(), std::move(data));
+    }
+
+    void erase(iterator it){
+        if(it != end()){
+            const Index current    = it.getCurrentIndex();
+            const Index previous   = _pool.link(current).getPrevious();
+            const Index next       = _pool.link(current).getNext();
+
+            _pool.link(next).setPrevious(previous);
+            _pool.link(previous).setNext(next);
+
+            _shared.releaseSlot(current);
+            _size--;
+        }
+    }
+
+    void pop_front(){
+        erase(begin());
+    }
+    void pop_back(){
+        erase(iterator(this, _pool.link(_head).getPrevious()));
+    }
+
+    void clear(){
+        for(Index index = _pool.link(_head).getNext(); index != _head;){
+            const Index next = _pool.link(index).getNext();
+            _shared.releaseSlot(index);
+            index = next;
+        }
+        _pool.link(_head).setPrevious(_head);
+        _pool.link(_head).setNext(_head);
+        _size = 0;
+    }
+
+    // moves the element at it from other to behind position
+    void splice(iterator position, SharedIndexList& other, iterator it){
+        checkShared(other);
+        const Index current = it.getCurrentIndex();
+        if(current == position.getCurrentIndex() || current == other._head){
+            return;
+        }
+        relinkRun(current, current, position.getCurrentIndex());
+        other._size--;
+        _size++;
+    }
+
+    // moves [first, last) of other, count elements long, to behind position.
+    // position must not lie within the range.
+    void splice(iterator position, SharedIndexList& other, iterator first, iterator last, size_t count){
+        checkShared(other);
+        if(first == last){
+            return;
+        }
+        relinkRun(first.getCurrentIndex(), _pool.link(last.getCurrentIndex()).getPrevious(), position.getCurrentIndex());
+        other._size -= static_cast<Index>(count);
+        _size       += static_cast<Index>(count);
+    }
+
+    // as above, counts the range unless other is this list
+    void splice(iterator position, SharedIndexList& other, iterator first, iterator last){
+        size_t count = 0;
+        if(&other != this){
+            for(auto it = first; it != last; ++it){
+                ++count;
+            }
+        }
+        splice(position, other, first, last, count);
+    }
+
+    // moves all elements of other to behind position
+    void splice(iterator position, SharedIndexList& other){
+        if(&other != this){
+            splice(position, other, other.begin(), other.end(), other._size);
+        }
+    }
+
+    // merges the sorted other into this sorted list, elements of other go
+    // behind equal ones of this list. Runs of other are relinked as a whole.
+    template <class Compare>
+    void merge(SharedIndexList& other, Compare cmp){
+        checkShared(other);
+        if(&other == this){
+            return;
+        }
+        Index current   = _pool.link(_head).getNext();
+        Index source    = _pool.link(other._head).getNext();
+        while(source != other._head){
+            if(current == _head){
+                relinkRun(source, _pool.link(other._head).getPrevious(), _pool.link(_head).getPrevious());
+                break;
+            }
+            if(cmp(_pool.data(source), _pool.data(current))){
+                Index runEnd = source;
+                for(Index next = _pool.link(runEnd).getNext(); next != other._head && cmp(_pool.data(next), _pool.data(current)); next = _pool.link(runEnd).getNext()){
+                    runEnd = next;
+                }
+                const Index nextSource = _pool.link(runEnd).getNext();
+                relinkRun(source, runEnd, _pool.link(current).getPrevious());
+                source = nextSource;
+            }
+            current = _pool.link(current).getNext();
+        }
+        _size       += other._size;
+        other._size = 0;
+    }
+
+    void merge(SharedIndexList& other){
+        merge(other, std::less<T>());
+    }
+
+    size_t size() const{
+        return _size;
+    }
+    bool empty() const{
+        return (_size == 0);
+    }
+
+    shared_pool_type& shared(){
+        return _shared;
+    }
+
+    pool_type& _pool;
+
+    private:
+    shared_pool_type& _shared;
+    const Index _head;
+    Index _size = 0;
+
+    void checkShared(const SharedIndexList& other) const{
+        if(&other._shared != &_shared){
+            throw std::invalid_argument("SharedIndexList: lists do not share a pool");
+        }
+    }
+
+    // unlinks [first, last], last included, and links it behind position
+    void relinkRun(Index first, Index last, Index position){
+        const Index before  = _pool.link(first).getPrevious();
+        const Index after   = _pool.link(last).getNext();
+        _pool.link(before).setNext(after);
+        _pool.link(after).setPrevious(before);
+
+        const Index positionNext = _pool.link(position).getNext();
+        _pool.link(first).setPrevious(position);
+        _pool.link(last).setNext(positionNext);
+        _pool.link(positionNext).setPrevious(last);
+        _pool.link(position).setNext(first);
+    }
+
+    // positions are never tracked, see IndexList::isOrdered()
+    bool isOrdered() const{
+        return false;
+    }
+    Index orderedAdvance(Index index, size_t, bool) const{
+        return index;
+    }
+
+    friend iterator;
+    friend reverse_iterator;
+};
+
+#endif // SHAREDINDEXLIST_H
@@ -0,0 +1,401 @@
+// Benchmark suite for IndexList and the std containers. Every case runs a
+// few warmup repetitions and then the measured ones, setup and teardown are
+// left out of the timing. Results are written as CSV (or JSON with --json)
+// so runs of different releases can be compared.
+//
+//  benchmark [--reps N] [--warmup N] [--count N]... [--filter TEXT] [--json]
+
+#include "../indexlist.h"
+#include "../indexforwardlist.h"
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <list>
+#include <deque>
+#include <forward_list>
+#include <random>
+#include <algorithm>
+#include <numeric>
+
+template <size_t Size>
+struct Payload{
+    uint8_t bytes[Size];
+
+    Payload(){}
+    Payload(size_t value){
+        bytes[0] = static_cast<uint8_t>(value);
+    }
+};
+
+// keeps measured loops from being optimized away
+static volatile size_t sink = 0;
+
+struct BenchmarkResult{
+    std::string operation;
+    std::string container;
+    size_t      payload;
+    size_t      count;
+    size_t      repetitions;
+    double      min;
+    double      median;
+    double      mean;
+    double      stddev;
+};
+
+struct BenchmarkOptions{
+    size_t                  repetitions = 10;
+    size_t                  warmup      = 2;
+    std::vector<size_t>     counts      = {1000, 100000};
+    std::string             filter;
+    bool                    json        = false;
+};
+
+class BenchmarkRunner{
+    public:
+
+    explicit BenchmarkRunner(const BenchmarkOptions& options) : _options(options){}
+
+    // times body(state) on a fresh setup() state per repetition, in ns
+    template <class Setup, class Body>
+    void measure(const char* operation, const char* container, size_t payload, size_t count, Setup setup, Body body){
+        const std::string name = std::string(container) + "/" + operation;
+        if(!_options.filter.empty() && name.find(_options.filter) == std::string::npos){
+            return;
+        }
+
+        std::vector<double> samples;
+        for(size_t repetition = 0; repetition < _options.warmup + _options.repetitions; repetition++){
+            auto state = setup();
+            auto start = std::chrono::steady_clock::now();
+            body(state);
+            auto end = std::chrono::steady_clock::now();
+            if(repetition >= _options.warmup){
+                samples.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+            }
+        }
+
+        std::sort(samples.begin(), samples.end());
+        const double mean   = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+        double variance     = 0;
+        for(double sample : samples){
+            variance += (sample - mean) * (sample - mean);
+        }
+        const size_t middle = samples.size() / 2;
+        const double median = (samples.size() % 2) ? samples[middle] : (samples[middle - 1] + samples[middle]) / 2;
+
+        _results.push_back({operation, container, payload, count, samples.size(), samples.front(), median, mean, std::sqrt(variance / samples.size())});
+    }
+
+    void print(std::ostream& out) const{
+        if(_options.json){
+            out<<"[\n";
+            for(size_t index = 0; index < _results.size(); index++){
+                const auto& result = _results[index];
+                out<<"  {\"operation\": \""<<result.operation<<"\", \"container\": \""<<result.container
+                   <<"\", \"payload\": "<<result.payload<<", \"count\": "<<result.count
+                   <<", \"repetitions\": "<<result.repetitions<<", \"min_ns\": "<<result.min
+                   <<", \"median_ns\": "<<result.median<<", \"mean_ns\": "<<result.mean
+                   <<", \"stddev_ns\": "<<result.stddev<<", \"ns_per_element\": "<<result.median / result.count
+                   <<"}"<<((index + 1 < _results.size()) ? ",\n" : "\n");
+            }
+            out<<"]\n";
+            return;
+        }
+        out<<"operation,container,payload,count,repetitions,min_ns,median_ns,mean_ns,stddev_ns,ns_per_element\n";
+        for(const auto& result : _results){
+            out<<result.operation<<','<<result.container<<','<<result.payload<<','<<result.count<<','
+               <<result.repetitions<<','<<result.min<<','<<result.median<<','<<result.mean<<','
+               <<result.stddev<<','<<result.median / result.count<<'\n';
+        }
+    }
+
+    private:
+    BenchmarkOptions                _options;
+    std::vector<BenchmarkResult>    _results;
+};
+
+template <class C>
+constexpr bool isForwardList = false;
+template <class T>
+constexpr bool isForwardList<std::forward_list<T>> = true;
+template <class T, class Index, class Allocator>
+constexpr bool isForwardList<IndexForwardList<T, Index, Allocator>> = true;
+
+template <class C>
+constexpr bool isIndexList = false;
+template <class T, class Layout, class Index, class Allocator>
+constexpr bool isIndexList<IndexList<T, Layout, Index, Allocator>> = true;
+
+// std::list, std::forward_list and IndexList erase by predicate in one pass
+template <class C, class = void>
+constexpr bool hasRemoveIf = false;
+template <class C>
+constexpr bool hasRemoveIf<C, std::void_t<decltype(std::declval<C&>().remove_if(std::declval<bool (*)(const typename C::value_type&)>()))>> = true;
+
+// contiguous containers have no cheap insert or erase in the middle
+template <class C>
+constexpr bool isNodeBased = !std::is_same_v<C, std::vector<typename C::value_type>> && !std::is_same_v<C, std::deque<typename C::value_type>>;
+
+template <class C>
+void fill(C& container, size_t count){
+    using T = typename C::value_type;
+    if constexpr(std::is_same_v<C, std::forward_list<T>>){
+        auto last = container.before_begin();
+        for(size_t index = 0; index < count; index++){
+            last = container.emplace_after(last, index);
+        }
+    }
+    else{
+        for(size_t index = 0; index < count; index++){
+            container.emplace_back(index);
+        }
+    }
+}
+
+template <class C>
+C filled(size_t count){
+    C container;
+    fill(container, count);
+    return container;
+}
+
+// inserts one element behind every 8th one
+template <class C>
+void insertEvery8th(C& container){
+    size_t position = 0;
+    if constexpr(isForwardList<C>){
+        for(auto it = container.begin(); it != container.end(); ++it, ++position){
+            if(position % 8 == 7){
+                it = container.emplace_after(it, position);
+            }
+        }
+    }
+    else if constexpr(isIndexList<C>){
+        for(auto it = container.begin(); it != container.end(); ++it, ++position){
+            if(position % 8 == 7){
+                it = container.emplace(it, position);
+            }
+        }
+    }
+    else{
+        for(auto it = container.begin(); it != container.end(); ++it, ++position){
+            if(position % 8 == 7){
+                it = container.emplace(std::next(it), position);
+            }
+        }
+    }
+}
+
+// erases every other element with one erase() or erase_after() call each
+template <class C>
+void eraseEveryOtherElementwise(C& container){
+    if constexpr(isForwardList<C>){
+        for(auto it = container.begin(); it != container.end(); ++it){
+            if(std::next(it) == container.end()){
+                break;
+            }
+            container.erase_after(it);
+        }
+    }
+    else{
+        for(auto it = container.begin(); it != container.end();){
+            if(++it == container.end()){
+                break;
+            }
+            it = container.erase(it);
+        }
+    }
+}
+
+// the same through remove_if() with one position counting predicate for
+// all containers that have it, element by element where there is none
+template <class C>
+void eraseEveryOther(C& container){
+    size_t position = 0;
+    const auto odd = [&position](const auto&){
+        return (position++ % 2) == 1;
+    };
+    if constexpr(hasRemoveIf<C>){
+        container.remove_if(odd);
+    }
+    else if constexpr(isNodeBased<C>){
+        eraseEveryOtherElementwise(container);
+    }
+    else{
+        container.erase(std::remove_if(container.begin(), container.end(), odd), container.end());
+    }
+}
+
+template <class C>
+size_t iterate(C& container){
+    size_t sum = 0;
+    for(const auto& value : container){
+        sum += value.bytes[0];
+    }
+    return sum;
+}
+
+// element iterators in random order, node containers keep them valid
+template <class C>
+std::vector<typename C::iterator> shuffledIterators(C& container, size_t seed){
+    std::vector<typename C::iterator> iterators;
+    for(auto it = container.begin(); it != container.end(); ++it){
+        iterators.push_back(it);
+    }
+    std::shuffle(iterators.begin(), iterators.end(), std::mt19937(seed));
+    return iterators;
+}
+
+// scatters an IndexList over its pool by erasing and refilling random slots
+template <class C>
+void scatter(C& container){
+    const size_t count  = container.size();
+    auto iterators      = shuffledIterators(container, 5);
+    for(size_t index = 0; index < count / 2; index++){
+        container.erase(iterators[index]);
+    }
+    std::mt19937 random(9);
+    for(size_t index = count / 2; index < count; index++){
+        container.emplace(iterators[count / 2 + random() % (count - count / 2)], index);
+    }
+}
+
+template <class C>
+void benchContainer(BenchmarkRunner& runner, const char* name, size_t payload, size_t count){
+    using T = typename C::value_type;
+
+    runner.measure("push_back", name, payload, count, [](){
+        return C();
+    }, [count](C& container){
+        fill(container, count);
+    });
+
+    if constexpr(!std::is_same_v<C, std::vector<T>>){
+        runner.measure("push_front", name, payload, count, [](){
+            return C();
+        }, [count](C& container){
+            for(size_t index = 0; index < count; index++){
+                container.emplace_front(index);
+            }
+        });
+    }
+
+    runner.measure("iterate", name, payload, count, [count](){
+        return filled<C>(count);
+    }, [](C& container){
+        sink = sink + iterate(container);
+    });
+
+    if constexpr(isNodeBased<C>){
+        runner.measure("insert_every_8th", name, payload, count, [count](){
+            return filled<C>(count);
+        }, [](C& container){
+            insertEvery8th(container);
+        });
+    }
+
+    runner.measure("erase_every_other", name, payload, count, [count](){
+        return filled<C>(count);
+    }, [](C& container){
+        eraseEveryOther(container);
+    });
+
+    if constexpr(isNodeBased<C>){
+        runner.measure("erase_every_other_elementwise", name, payload, count, [count](){
+            return filled<C>(count);
+        }, [](C& container){
+            eraseEveryOtherElementwise(container);
+        });
+    }
+
+    if constexpr(isNodeBased<C> && !isForwardList<C>){
+        runner.measure("random_erase", name, payload, count, [count](){
+            auto container  = std::make_unique<C>(filled<C>(count));
+            auto iterators  = shuffledIterators(*container, 3);
+            return std::make_pair(std::move(container), std::move(iterators));
+        }, [](auto& state){
+            for(auto& it : state.second){
+                state.first->erase(it);
+            }
+        });
+    }
+
+    if constexpr(isIndexList<C>){
+        runner.measure("iterate_scattered", name, payload, count, [count](){
+            auto container = filled<C>(count);
+            scatter(container);
+            return container;
+        }, [](C& container){
+            sink = sink + iterate(container);
+        });
+
+        runner.measure("reorder_scattered", name, payload, count, [count](){
+            auto container = filled<C>(count);
+            scatter(container);
+            return container;
+        }, [](C& container){
+            container.reorder();
+        });
+    }
+
+    runner.measure("clear", name, payload, count, [count](){
+        return filled<C>(count);
+    }, [](C& container){
+        container.clear();
+    });
+}
+
+template <size_t Size>
+void benchPayload(BenchmarkRunner& runner, size_t count){
+    using T = Payload<Size>;
+
+    benchContainer<IndexList<T>>(runner, "IndexList", Size, count);
+    benchContainer<IndexList<T, SplitIndexLayout>>(runner, "SplitIndexList", Size, count);
+    benchContainer<IndexForwardList<T>>(runner, "IndexForwardList", Size, count);
+    benchContainer<std::list<T>>(runner, "list", Size, count);
+    benchContainer<std::forward_list<T>>(runner, "forward_list", Size, count);
+    benchContainer<std::deque<T>>(runner, "deque", Size, count);
+    benchContainer<std::vector<T>>(runner, "vector", Size, count);
+}
+
+int main(int argc, char** argv){
+    BenchmarkOptions options;
+    bool countsGiven = false;
+    for(int arg = 1; arg < argc; arg++){
+        const std::string option = argv[arg];
+        const bool hasValue      = (arg + 1 < argc);
+        if(option == "--reps" && hasValue){
+            options.repetitions = std::max<size_t>(1, std::stoul(argv[++arg]));
+        }
+        else if(option == "--warmup" && hasValue){
+            options.warmup = std::stoul(argv[++arg]);
+        }
+        else if(option == "--count" && hasValue){
+            if(!countsGiven){
+                options.counts.clear();
+                countsGiven = true;
+            }
+            options.counts.push_back(std::max<size_t>(1, std::stoul(argv[++arg])));
+        }
+        else if(option == "--filter" && hasValue){
+            options.filter = argv[++arg];
+        }
+        else if(option == "--json"){
+            options.json = true;
+        }
+        else{
+            std::cerr<<"usage: "<<argv[0]<<" [--reps N] [--warmup N] [--count N]... [--filter TEXT] [--json]\n";
+            return 1;
+        }
+    }
+
+    BenchmarkRunner runner(options);
+    for(size_t count : options.counts){
+        benchPayload<8>(runner, count);
+        benchPayload<64>(runner, count);
+        benchPayload<256>(runner, count);
+    }
+    runner.print(std::cout);
+}
@@ -104,4 +104,11 @@ int main(){
         printf("pool ele[%d]: [%d;%d] data: %d\n",i, il._pool[i].getPrevious(), il._pool[i].getNext(), il._pool[i].getData());
     }
     std::cout<<"Front: "<< il.front()<< "  Back: "<<il.back() << "  Size: "<<il.size()<<"  Capacity: "<<il.capacity()<<'\n';
+
+    auto handle = il.handle(il.begin()+1);
+    il.erase(il.begin());
+    il.shrink_to_fit();
+    std::cout<<"Handle valid: "<<il.contains(handle)<<"  Value: "<<*il.get(handle)<<'\n';
+    il.erase(handle);
+    std::cout<<"Handle valid after erase: "<<il.contains(handle)<<'\n';
 }
\ No newline at end of file
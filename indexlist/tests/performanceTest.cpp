@@ -1,4 +1,10 @@
 #include "../indexlist.h"
+#include "../concurrentindexlist.h"
+#include "../parallelindexlist.h"
+#include "../unrolledindexlist.h"
+#include "../indexforwardlist.h"
+#include "../sharedindexlist.h"
+#include "../indexsnapshot.h"
 
 
 #include <iostream>
@@ -8,14 +14,24 @@
 #include <list>
 #include <forward_list>
 #include <deque>
+#include <random>
+#include <mutex>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#if defined(__unix__)
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 template <typename T>
-void printList(IndexList<T> list, bool raw = true){
+void printList(const IndexList<T>& list, bool raw = true){
 
     if(raw){
         for(int i = 0; i < list._pool.size(); i++){
-            std::cout<<"Pool Value["<<i<<"]: "<<list._pool[i].getData()<<" ["<<list._pool[i].getPrevious()<<"|"<<list._pool[i].getNext()<<"]";
-            if(i == list._pool[i].getPrevious()){
+            std::cout<<"Pool Value["<<i<<"]: "<<list._pool.data(i)<<" ["<<list._pool.link(i).getPrevious()<<"|"<<list._pool.link(i).getNext()<<"]";
+            if(i == list._pool.link(i).getPrevious()){
                 std::cout<<"(deleted)\n";
             }
             else{
@@ -24,15 +40,15 @@ void printList(IndexList<T> list, bool raw = true){
         }
     }
     else{
-        for(auto it = list.begin(); it != list.end(); it++){
+        for(auto it = list.cbegin(); it != list.cend(); it++){
             std::cout<<"List Value["<<it.getCurrentIndex()<<"]: "<<*it<<" ["<<it.getPreviousIndex()<<"|"<<it.getNextIndex()<<"]\n";
         }
         if(list._eraseListBegin != 0){
            std::cout<<"\n";
             size_t current = list._eraseListBegin;
             do{
-                std::cout<<"Erased Value["<<current<<"]: "<<list._pool[current].getData()<<" ["<<list._pool[current].getPrevious()<<"|"<<list._pool[current].getNext()<<"]\n";
-                current = list._pool[current].getNext();
+                std::cout<<"Erased Value["<<current<<"]: "<<list._pool.data(current)<<" ["<<list._pool.link(current).getPrevious()<<"|"<<list._pool.link(current).getNext()<<"]\n";
+                current = list._pool.link(current).getNext();
             }
             while(current != 0);
         }
@@ -51,6 +67,1137 @@ struct A{
     A(){}
 };
 
+template <typename List>
+void layoutTest(const char* name){
+    List indexList;
+
+    auto start =  chrono::high_resolution_clock::now();
+    for(size_t count = 0; count < 400000; count++){
+        indexList.emplace_back();
+    }
+    auto end = chrono::high_resolution_clock::now();
+    auto timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_emplace_back "<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    //erase every other element, only links are touched
+    start =  chrono::high_resolution_clock::now();
+    for(auto it = indexList.begin(); it != indexList.end();){
+        auto tmp = it;
+        it = it + 2;
+        indexList.erase(tmp);
+    }
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_erase_every_other "<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    start =  chrono::high_resolution_clock::now();
+    size_t links = 0;
+    for(auto it = indexList.begin(); it != indexList.end(); ++it){
+        links += it.getNextIndex();
+    }
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_link_walk ("<<links<<")"<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    start =  chrono::high_resolution_clock::now();
+    indexList.reorder();
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_reorder "<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+}
+
+// sums the payloads in list order, walks the pool in strides when the list is
+// out of pool order
+template <typename List>
+void scanTest(List& list, const char* name, const char* op){
+    auto start =  chrono::high_resolution_clock::now();
+    size_t sum = 0;
+    for(const auto& obj : list){
+        sum += obj._[0];
+    }
+    auto end = chrono::high_resolution_clock::now();
+    auto timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<op<<" ("<<sum<<")"<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+}
+
+template <typename List>
+void reorderTest(const char* name){
+    List list;
+    //inserting after random earlier elements scatters the list over the pool
+    std::vector<typename List::iterator> inserted;
+    std::mt19937 random(7);
+    inserted.push_back(list.emplace_back(static_cast<uint8_t>(0)));
+    for(size_t count = 1; count < 400000; count++){
+        inserted.push_back(list.emplace(inserted[random() % inserted.size()], static_cast<uint8_t>(count)));
+    }
+    List stepList = list;
+
+    scanTest(list, name, "_scan_scattered");
+
+    auto start =  chrono::high_resolution_clock::now();
+    list.reorder();
+    auto end = chrono::high_resolution_clock::now();
+    auto timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_reorder_scattered "<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    scanTest(list, name, "_scan_reordered");
+
+    start =  chrono::high_resolution_clock::now();
+    size_t steps = 1;
+    while(!stepList.reorderStep(4096)){
+        steps++;
+    }
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_reorder_step_4096 ("<<steps<<" calls)"<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+}
+
+// save and restore through a file, element by element against a snapshot
+template <typename List>
+void snapshotTest(const char* name){
+    const char* path = "performanceTest.snapshot";
+    List list;
+    for(size_t count = 0; count < 400000; count++){
+        list.emplace_back(static_cast<uint8_t>(count));
+    }
+
+    auto start =  chrono::high_resolution_clock::now();
+    {
+        std::ofstream out(path, std::ios::binary);
+        for(const auto& obj : list){
+            out.write(reinterpret_cast<const char*>(&obj), sizeof(obj));
+        }
+    }
+    auto end = chrono::high_resolution_clock::now();
+    auto timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_elementwise_save "<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    // loads are timed up to the filled list, its destruction is left out
+    size_t loadedSize = 0;
+    start =  chrono::high_resolution_clock::now();
+    {
+        std::ifstream in(path, std::ios::binary);
+        List loaded;
+        A obj;
+        while(in.read(reinterpret_cast<char*>(&obj), sizeof(obj))){
+            loaded.emplace_back(obj);
+        }
+        end = chrono::high_resolution_clock::now();
+        loadedSize = loaded.size();
+    }
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_elementwise_load ("<<loadedSize<<")"<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    // both saves start from a fresh file
+    std::remove(path);
+
+    start =  chrono::high_resolution_clock::now();
+    {
+        std::ofstream out(path, std::ios::binary);
+        writeIndexSnapshot(list, out);
+    }
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_snapshot_save "<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    start =  chrono::high_resolution_clock::now();
+    {
+        std::ifstream in(path, std::ios::binary);
+        List loaded = readIndexSnapshot<List>(in);
+        end = chrono::high_resolution_clock::now();
+        loadedSize = loaded.size();
+    }
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_snapshot_load ("<<loadedSize<<")"<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    // a snapshot of a list out of pool order claiming to be ordered is
+    // rejected, its iterator jumps would land on the wrong elements
+    {
+        List reversed;
+        for(size_t count = 0; count < 16; count++){
+            reversed.emplace_front(static_cast<uint8_t>(count));
+        }
+        std::ostringstream out;
+        writeIndexSnapshot(reversed, out);
+        const std::string bytes = out.str();
+        std::vector<uint64_t> buffer((bytes.size() + 7) / 8);
+        memcpy(buffer.data(), bytes.data(), bytes.size());
+        reinterpret_cast<IndexSnapshotHeader*>(buffer.data())->flags |= IndexSnapshotHeader::orderedFlag;
+
+        size_t rejected = 0;
+        try{
+            readIndexSnapshot<List>(buffer.data(), bytes.size());
+        }
+        catch(const std::runtime_error&){
+            rejected++;
+        }
+        try{
+            IndexListView<A, typename List::index_type> flagged(buffer.data(), bytes.size());
+        }
+        catch(const std::runtime_error&){
+            rejected++;
+        }
+        if(rejected != 2){
+            std::cout<<name<<" Wrong ordered flag accepted"<<std::endl;
+        }
+    }
+
+#if defined(__unix__)
+    start =  chrono::high_resolution_clock::now();
+    const int file      = open(path, O_RDONLY);
+    const size_t bytes  = static_cast<size_t>(lseek(file, 0, SEEK_END));
+    void* mapped        = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, file, 0);
+    IndexListView<A, typename List::index_type> view(mapped, bytes);
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_snapshot_map ("<<view.size()<<")"<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    start =  chrono::high_resolution_clock::now();
+    IndexListView<A, typename List::index_type> trusted(mapped, bytes, false);
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_snapshot_map_unchecked ("<<trusted.size()<<")"<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    start =  chrono::high_resolution_clock::now();
+    size_t sum = 0;
+    for(const auto& obj : view){
+        sum += obj._[0];
+    }
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_snapshot_view_scan ("<<sum<<")"<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    munmap(mapped, bytes);
+    close(file);
+#endif
+    std::remove(path);
+}
+
+void printStats(const IndexListStats& stats, const char* name, const char* op){
+    std::cout<<name<<op<<" live: "<<stats.liveNodes<<" free: "<<stats.freeSlots
+             <<" erase list: "<<stats.eraseListLength<<" capacity: "<<stats.capacity
+             <<" link distance: "<<stats.averageLinkDistance<<" growths: "<<stats.growthCount
+             <<" fragmentation: "<<stats.fragmentation()<<std::endl;
+}
+
+// random erase/append churn with and without auto-compaction
+template <typename List>
+void statsTest(const char* name, double threshold){
+    List list;
+    list.setAutoCompaction(threshold);
+    std::mt19937 random(3);
+
+    auto start =  chrono::high_resolution_clock::now();
+    for(size_t count = 0; count < 200000; count++){
+        list.emplace_back(static_cast<uint8_t>(count));
+    }
+    for(size_t round = 0; round < 4; round++){
+        list.erase_if([&random](const A&){
+            return (random() % 4 != 0);
+        });
+        for(size_t count = 0; count < 100000; count++){
+            list.emplace_back(static_cast<uint8_t>(count));
+        }
+    }
+    auto end = chrono::high_resolution_clock::now();
+    auto timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_churn "<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    start =  chrono::high_resolution_clock::now();
+    auto stats = list.stats();
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    printStats(stats, name, "_stats");
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    start =  chrono::high_resolution_clock::now();
+    size_t sum = 0;
+    for(const auto& obj : list){
+        sum += obj._[0];
+    }
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_scan_after_churn ("<<sum<<")"<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    //erase two of every three elements through the iterator erase()
+    //returns, the compaction it triggers moves the remaining elements
+    const size_t before = list.size();
+    start =  chrono::high_resolution_clock::now();
+    for(auto it = list.begin(); it != list.end();){
+        it = list.erase(it);
+        if(it != list.end()){
+            it = list.erase(it);
+        }
+        if(it != list.end()){
+            ++it;
+        }
+    }
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    if(list.size() != before / 3 || static_cast<size_t>(std::distance(list.begin(), list.end())) != list.size()){
+        std::cout<<name<<" List broken by elementwise erase"<<std::endl;
+    }
+    std::cout<<name<<"_erase_two_of_three ("<<list.size()<<")"<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+}
+
+template <typename List>
+void fillList(List& list, size_t count){
+    for(size_t index = 0; index < count; index++){
+        list.emplace_back(static_cast<uint8_t>(index));
+    }
+}
+
+template <typename List>
+size_t sumList(const List& list){
+    size_t sum = 0;
+    for(auto it = list.cbegin(); it != list.cend(); ++it){
+        sum += it->_[0];
+    }
+    return sum;
+}
+
+// threadCount readers traversing one list, through a const reference and
+// each on its own copy
+template <typename List>
+void constReadTest(const char* name, size_t threadCount){
+    List list;
+    for(size_t count = 0; count < 400000; count++){
+        list.emplace_back(static_cast<uint8_t>(count));
+    }
+    const List& shared = list;
+    std::vector<size_t> sums(threadCount);
+    std::vector<std::thread> threads;
+
+    auto start =  chrono::high_resolution_clock::now();
+    for(size_t thread = 0; thread < threadCount; thread++){
+        threads.emplace_back([&shared, &sums, thread](){
+            sums[thread] = sumList(shared);
+        });
+    }
+    for(auto& thread : threads){
+        thread.join();
+    }
+    auto end = chrono::high_resolution_clock::now();
+    auto timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_const_readers_"<<threadCount<<" ("<<sums[0]<<")"<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    threads.clear();
+
+    start =  chrono::high_resolution_clock::now();
+    for(size_t thread = 0; thread < threadCount; thread++){
+        threads.emplace_back([&shared, &sums, thread](){
+            List copy = shared;
+            sums[thread] = sumList(copy);
+        });
+    }
+    for(auto& thread : threads){
+        thread.join();
+    }
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_copying_readers_"<<threadCount<<" ("<<sums[0]<<")"<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+}
+
+// reads one byte per cache line of the payload
+inline size_t touchPayload(const A& obj){
+    return obj._[0] + obj._[64] + obj._[128] + obj._[192];
+}
+
+// reads the whole payload and does some work on it
+inline size_t hashPayload(const A& obj){
+    size_t hash = 0;
+    for(size_t index = 0; index < sizeof(obj._); index++){
+        hash = hash * 31 + obj._[index];
+    }
+    return hash;
+}
+
+// list whose order is unrelated to the slot order, every element is linked
+// in behind a random earlier one
+template <typename List>
+void shuffledList(List& list, size_t count){
+    std::vector<typename List::iterator> iterators;
+    std::mt19937 random(11);
+    iterators.push_back(list.emplace_back(uint8_t(0)));
+    for(size_t index = 1; index < count; index++){
+        iterators.push_back(list.emplace(iterators[random() % iterators.size()], static_cast<uint8_t>(index)));
+    }
+}
+
+template <typename List, typename Func>
+void prefetchTest(List& list, const char* name, const char* op, Func func){
+    auto start =  chrono::high_resolution_clock::now();
+    size_t sum = 0;
+    for(const auto& obj : list){
+        sum += func(obj);
+    }
+    auto end = chrono::high_resolution_clock::now();
+    auto timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<op<<"_scan ("<<sum<<")"<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    for(size_t distance : {2, 4, 8, 16}){
+        start =  chrono::high_resolution_clock::now();
+        sum = 0;
+        list.for_each_prefetched([&sum, &func](const A& obj){
+            sum += func(obj);
+        }, distance);
+        end = chrono::high_resolution_clock::now();
+        timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+        std::cout<<name<<op<<"_prefetched_"<<distance<<" ("<<sum<<")"<<std::endl;
+        std::cout<<"Time difference: "<<timeDiff<<" us\n";
+    }
+}
+
+template <typename List>
+void prefetchTest(const char* name){
+    List list;
+    shuffledList(list, 400000);
+
+    prefetchTest(list, name, "_shuffled_touch", touchPayload);
+    prefetchTest(list, name, "_shuffled_hash", hashPayload);
+}
+
+template <typename List>
+void clearTest(const char* name){
+    List list;
+    fillList(list, 400000);
+
+    auto start =  chrono::high_resolution_clock::now();
+    while(!list.empty()){
+        list.pop_front();
+    }
+    auto end = chrono::high_resolution_clock::now();
+    auto timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_pop_front_all "<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    list = List();
+    fillList(list, 400000);
+
+    start =  chrono::high_resolution_clock::now();
+    list.clear();
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_clear "<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    start =  chrono::high_resolution_clock::now();
+    fillList(list, 400000);
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_refill_after_clear ("<<list.size()<<")"<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+}
+
+// listCount lists of length elements built up and torn down once per
+// frame, release() runs after each frame to hand an arena back
+template <typename List, typename Release>
+void frameTest(const char* name, size_t listCount, size_t length, const typename List::allocator_type& allocator, Release release){
+    size_t sum = 0;
+
+    auto start =  chrono::high_resolution_clock::now();
+    for(size_t frame = 0; frame < 100; frame++){
+        {
+            std::deque<List> lists;
+            for(size_t index = 0; index < listCount; index++){
+                List& list = lists.emplace_back(allocator);
+                for(size_t count = 0; count < length; count++){
+                    list.emplace_back(static_cast<uint8_t>(count));
+                }
+            }
+            for(auto& list : lists){
+                for(const auto& obj : list){
+                    sum += obj._[0];
+                }
+            }
+        }
+        release();
+    }
+    auto end = chrono::high_resolution_clock::now();
+    auto timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_frames_"<<listCount<<"x"<<length<<" ("<<sum<<")"<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+}
+
+#if __has_include(<memory_resource>)
+// pmr lists nested in a pmr vector, the vector hands its resource down to
+// every list it constructs and moves them over when it grows
+template <typename List>
+void nestedFrameTest(const char* name, size_t listCount, size_t length, std::pmr::monotonic_buffer_resource& arena){
+    size_t sum = 0;
+    size_t foreign = 0;
+
+    auto start =  chrono::high_resolution_clock::now();
+    for(size_t frame = 0; frame < 100; frame++){
+        {
+            std::pmr::vector<List> lists(&arena);
+            for(size_t index = 0; index < listCount; index++){
+                List& list = lists.emplace_back();
+                for(size_t count = 0; count < length; count++){
+                    list.emplace_back(static_cast<uint8_t>(count));
+                }
+            }
+            for(const auto& list : lists){
+                foreign += (list.get_allocator().resource() != &arena);
+                for(const auto& obj : list){
+                    sum += obj._[0];
+                }
+            }
+        }
+        arena.release();
+    }
+    auto end = chrono::high_resolution_clock::now();
+    auto timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_nested_frames_"<<listCount<<"x"<<length<<" ("<<sum<<")"<<std::endl;
+    if(foreign){
+        std::cout<<"Lists not on the arena: "<<foreign<<std::endl;
+    }
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+}
+#endif
+
+template <typename List, typename Release>
+void allocatorTest(const char* name, const typename List::allocator_type& allocator, Release release){
+    frameTest<List>(name, 1, 20000, allocator, release);
+    frameTest<List>(name, 2000, 10, allocator, release);
+}
+
+void allocatorTest(){
+    allocatorTest<IndexList<A>>("IndexList", {}, [](){});
+
+#if __has_include(<memory_resource>)
+    // pools double their way up, the arena has room for a whole frame
+    std::vector<std::byte> buffer(32 << 20);
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+    allocatorTest<pmr::IndexList<A>>("PmrIndexListMonotonic", &arena, [&arena](){
+        arena.release();
+    });
+    allocatorTest<pmr::IndexList<A, SplitIndexLayout>>("PmrSplitIndexListMonotonic", &arena, [&arena](){
+        arena.release();
+    });
+
+    std::pmr::unsynchronized_pool_resource pool;
+    allocatorTest<pmr::IndexList<A>>("PmrIndexListPool", &pool, [](){});
+
+    nestedFrameTest<pmr::IndexList<A>>("PmrIndexListMonotonic", 2000, 10, arena);
+#endif
+}
+
+inline uint32_t sortKey(const A& obj){
+    return (obj._[0] << 8) | obj._[1];
+}
+inline uint32_t sortKey(int value){
+    return static_cast<uint32_t>(value);
+}
+
+template <typename List>
+void sortTest(const char* name){
+    using T = typename List::value_type;
+    List list;
+    std::vector<typename List::iterator> inserted;
+    std::mt19937 random(11);
+    auto make = [&random](){
+        T value;
+        if constexpr(std::is_same_v<T, A>){
+            value._[0] = static_cast<uint8_t>(random());
+            value._[1] = static_cast<uint8_t>(random());
+        }
+        else{
+            value = static_cast<T>(random() % 1000000);
+        }
+        return value;
+    };
+    inserted.push_back(list.emplace(list.end(), make()));
+    for(size_t count = 1; count < 200000; count++){
+        inserted.push_back(list.emplace(inserted[random() % inserted.size()], make()));
+    }
+
+    auto start =  chrono::high_resolution_clock::now();
+    list.sort([](const T& left, const T& right){
+        return sortKey(left) < sortKey(right);
+    });
+    auto end = chrono::high_resolution_clock::now();
+    auto timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_sort_scattered "<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    start =  chrono::high_resolution_clock::now();
+    size_t sum = 0;
+    for(const auto& obj : list){
+        sum += sortKey(obj);
+    }
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_scan_sorted ("<<sum<<")"<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+}
+
+template <typename List>
+void nthTest(List& list, const char* name, const char* op, size_t accesses){
+    std::mt19937 random(11);
+    auto start =  chrono::high_resolution_clock::now();
+    size_t sum = 0;
+    for(size_t count = 0; count < accesses; count++){
+        sum += (*list.nth(random() % list.size()))._[0];
+    }
+    auto end = chrono::high_resolution_clock::now();
+    auto timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<op<<" x"<<accesses<<" ("<<sum<<")"<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+}
+
+template <typename List>
+void positionTest(const char* name){
+    List list;
+    std::vector<typename List::iterator> inserted;
+    std::mt19937 random(7);
+    inserted.push_back(list.emplace_back(static_cast<uint8_t>(0)));
+    for(size_t count = 1; count < 400000; count++){
+        inserted.push_back(list.emplace(inserted[random() % inserted.size()], static_cast<uint8_t>(count)));
+    }
+
+    nthTest(list, name, "_nth_walk", 20);
+    list.setSkipIndex(64);
+    nthTest(list, name, "_nth_skip_index_64", 2000);
+    list.reorder();
+    nthTest(list, name, "_nth_ordered", 2000);
+}
+
+// every thread acquires and releases slots in batches of 64, the concurrent
+// pool with and without per-thread magazines against an IndexList behind a
+// mutex
+void concurrentAllocTest(size_t threadCount){
+    constexpr size_t rounds = 4000;
+    ConcurrentIndexList<A> concurrentList;
+    std::vector<std::thread> threads;
+
+    auto start =  chrono::high_resolution_clock::now();
+    for(size_t thread = 0; thread < threadCount; thread++){
+        threads.emplace_back([&concurrentList](){
+            uint32_t slots[64];
+            for(size_t round = 0; round < rounds; round++){
+                for(auto& slot : slots){
+                    slot = concurrentList.acquire(static_cast<uint8_t>(round));
+                }
+                for(auto slot : slots){
+                    concurrentList.release(slot);
+                }
+            }
+        });
+    }
+    for(auto& thread : threads){
+        thread.join();
+    }
+    auto end = chrono::high_resolution_clock::now();
+    auto timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<"ConcurrentIndexList_acquire_release_"<<threadCount<<"_threads "<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    threads.clear();
+
+    start =  chrono::high_resolution_clock::now();
+    for(size_t thread = 0; thread < threadCount; thread++){
+        threads.emplace_back([&concurrentList](){
+            auto magazine = concurrentList.magazine();
+            uint32_t slots[64];
+            for(size_t round = 0; round < rounds; round++){
+                for(auto& slot : slots){
+                    slot = concurrentList.acquire(magazine, static_cast<uint8_t>(round));
+                }
+                for(auto slot : slots){
+                    concurrentList.release(magazine, slot);
+                }
+            }
+        });
+    }
+    for(auto& thread : threads){
+        thread.join();
+    }
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<"ConcurrentIndexList_magazine_acquire_release_"<<threadCount<<"_threads "<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    IndexList<A> lockedList;
+    std::mutex lock;
+    threads.clear();
+
+    start =  chrono::high_resolution_clock::now();
+    for(size_t thread = 0; thread < threadCount; thread++){
+        threads.emplace_back([&lockedList, &lock](){
+            IndexList<A>::iterator slots[64];
+            for(size_t round = 0; round < rounds; round++){
+                for(auto& slot : slots){
+                    std::lock_guard<std::mutex> guard(lock);
+                    slot = lockedList.emplace_back(static_cast<uint8_t>(round));
+                }
+                for(auto& slot : slots){
+                    std::lock_guard<std::mutex> guard(lock);
+                    lockedList.erase(slot);
+                }
+            }
+        });
+    }
+    for(auto& thread : threads){
+        thread.join();
+    }
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<"LockedIndexList_emplace_erase_"<<threadCount<<"_threads "<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+}
+
+template <typename List>
+void parallelTest(const char* name){
+    IndexThreadPool threads;
+    List list;
+    for(size_t count = 0; count < 400000; count++){
+        list.emplace_back(static_cast<uint8_t>(count));
+    }
+    for(auto it = list.begin(); it != list.end();){
+        auto tmp = it;
+        it = it + 3;
+        list.erase(tmp);
+    }
+
+    auto start =  chrono::high_resolution_clock::now();
+    size_t sum = 0;
+    for(auto& obj : list){
+        obj._[1] = obj._[0] * 3;
+        sum += obj._[1];
+    }
+    auto end = chrono::high_resolution_clock::now();
+    auto timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_sequential_update ("<<sum<<")"<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    start =  chrono::high_resolution_clock::now();
+    parallelForEach(threads, list, [](A& obj){
+        obj._[1] = obj._[0] * 3;
+    });
+    sum = parallelTransformReduce(threads, list, size_t(0), std::plus<size_t>(), [](const A& obj) -> size_t{
+        return obj._[1];
+    });
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_parallel_update_"<<threads.size()<<"_threads ("<<sum<<")"<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    start =  chrono::high_resolution_clock::now();
+    parallelForEachOrdered(threads, list, [](A& obj, size_t position){
+        obj._[1] = static_cast<uint8_t>(position);
+    });
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_parallel_ordered_"<<threads.size()<<"_threads "<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+}
+
+// visits the live slots of a sparse pool, by checking the neighbours of each
+// node and with the occupancy bitmap
+template <typename List>
+void liveScanTest(const char* name){
+    List list;
+    for(size_t count = 0; count < 400000; count++){
+        list.emplace_back(static_cast<uint8_t>(count));
+    }
+    for(auto it = list.begin(); it != list.end();){
+        auto tmp = it;
+        it = it + 1;
+        if(tmp.getCurrentIndex() % 8){
+            list.erase(tmp);
+        }
+    }
+
+    auto start =  chrono::high_resolution_clock::now();
+    size_t live = 0;
+    for(size_t index = 1; index < list._pool.size(); index++){
+        live += !list.isNodeErased(list._pool.link(index));
+    }
+    auto end = chrono::high_resolution_clock::now();
+    auto timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_neighbour_scan ("<<live<<")"<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    start =  chrono::high_resolution_clock::now();
+    live = 0;
+    for(size_t index = list.findLive(1); index < list._pool.size(); index = list.findLive(index + 1)){
+        live++;
+    }
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_bitmap_scan ("<<live<<")"<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    start =  chrono::high_resolution_clock::now();
+    live = list.countLive(0, list._pool.size());
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_bitmap_count ("<<live<<")"<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+}
+
+template <typename List>
+void bulkTest(const char* name){
+    std::vector<A> source(400000);
+    List loopList;
+    List bulkList;
+
+    auto start =  chrono::high_resolution_clock::now();
+    for(const auto& obj : source){
+        loopList.push_back(obj);
+    }
+    auto end = chrono::high_resolution_clock::now();
+    auto timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_push_back_loop "<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    start =  chrono::high_resolution_clock::now();
+    bulkList.append_range(source);
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_append_range "<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    //refill erased slots in one batch
+    for(auto it = bulkList.begin(); it != bulkList.end();){
+        auto tmp = it;
+        it = it + 2;
+        bulkList.erase(tmp);
+    }
+    start =  chrono::high_resolution_clock::now();
+    bulkList.insert(bulkList.begin(), source.size() / 2, source.front());
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_insert_n_reuse "<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+}
+
+template <typename List>
+void removeIfTest(const char* name){
+    List list;
+    for(size_t count = 0; count < 400000; count++){
+        list.emplace_back(static_cast<uint8_t>(count));
+    }
+
+    auto start =  chrono::high_resolution_clock::now();
+    list.remove_if([](const A& obj){
+        return (obj._[0] & 1);
+    });
+    auto end = chrono::high_resolution_clock::now();
+    auto timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_remove_if "<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    start =  chrono::high_resolution_clock::now();
+    list.erase(std::next(list.begin(), list.size() / 2), list.end());
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_erase_range "<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    // a throwing predicate keeps what it erased so far erased and the rest
+    // in place, the list has to stay walkable both ways
+    const size_t before = list.size();
+    size_t tested       = 0;
+    try{
+        list.remove_if([&tested](const A&){
+            if(++tested == 1000){
+                throw std::runtime_error("remove_if");
+            }
+            return (tested & 1) == 1;
+        });
+    }
+    catch(const std::runtime_error&){
+    }
+    const size_t forward    = static_cast<size_t>(std::distance(list.begin(), list.end()));
+    const size_t backward   = static_cast<size_t>(std::distance(list.rbegin(), list.rend()));
+
+    std::cout<<name<<"_remove_if_throw ("<<before<<" -> "<<list.size()<<", walked "<<forward<<"/"<<backward<<")"<<std::endl;
+    if(list.size() != before - 500 || forward != list.size() || backward != list.size()){
+        std::cout<<"List broken by throwing predicate"<<std::endl;
+    }
+}
+
+template <typename List>
+void unrolledTest(const char* name){
+    List list;
+    auto start =  chrono::high_resolution_clock::now();
+    for(size_t count = 0; count < 400000; count++){
+        list.push_back(static_cast<int>(count));
+    }
+    auto end = chrono::high_resolution_clock::now();
+    auto timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_push_back "<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    start =  chrono::high_resolution_clock::now();
+    long long sum = 0;
+    for(auto& value : list){
+        sum += value;
+    }
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_range_loop ("<<sum<<")"<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    // inserts behind every 4th element, so blocks fill up and split
+    start =  chrono::high_resolution_clock::now();
+    for(auto it = list.begin(); it != list.end();){
+        it = list.insert(it, -1);
+        for(size_t step = 0; step < 4 && it != list.end(); step++){
+            ++it;
+        }
+    }
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_middle_insert ("<<list.size()<<")"<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    start =  chrono::high_resolution_clock::now();
+    for(auto it = list.begin(); it != list.end();){
+        if(*it >= 0){
+            ++it;
+        }
+        else if constexpr(std::is_void_v<decltype(list.erase(it))>){
+            auto tmp = it;
+            ++it;
+            list.erase(tmp);
+        }
+        else{
+            it = list.erase(it);
+        }
+    }
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_middle_erase ("<<list.size()<<")"<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+}
+
+// push_back for lists without one, std::forward_list appends after the
+// remembered last element
+template <typename List, typename Last>
+void queuePush(List& list, Last& last, size_t value){
+    if constexpr(std::is_same_v<List, std::forward_list<A>>){
+        last = list.emplace_after(last, static_cast<uint8_t>(value));
+    }
+    else{
+        list.emplace_back(static_cast<uint8_t>(value));
+    }
+}
+
+template <typename List>
+void forwardListTest(const char* name){
+    List list;
+    auto last = list.before_begin();
+
+    auto start =  chrono::high_resolution_clock::now();
+    for(size_t count = 0; count < 400000; count++){
+        queuePush(list, last, count);
+    }
+    auto end = chrono::high_resolution_clock::now();
+    auto timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_push_back "<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    start =  chrono::high_resolution_clock::now();
+    for(auto& obj : list){
+        obj._[0]+=1;
+    }
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_range_loop "<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    // FIFO churn, every pop_front is followed by a push_back reusing the slot
+    start =  chrono::high_resolution_clock::now();
+    for(size_t count = 0; count < 400000; count++){
+        list.pop_front();
+        queuePush(list, last, count);
+    }
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_queue_churn "<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    // inserts behind every 2nd element, then erases them again
+    start =  chrono::high_resolution_clock::now();
+    for(auto it = list.begin(); it != list.end(); ++it){
+        it = list.emplace_after(it);
+    }
+    for(auto it = list.begin(); it != list.end(); ++it){
+        list.erase_after(it);
+    }
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<name<<"_insert_erase_after "<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+}
+
+// ready/waiting queue handoff, every element moves from the front of one
+// list to the back of the other
+void sharedSpliceTest(){
+    const size_t count = 100000;
+    auto byKey = [](const A& left, const A& right){
+        return left._[0] < right._[0];
+    };
+
+    SharedIndexPool<A> pool;
+    SharedIndexList<A> ready(pool), waiting(pool);
+    IndexList<A> readyCopy, waitingCopy;
+    std::list<A> readyList, waitingList;
+    for(size_t index = 0; index < count; index++){
+        ready.emplace_back(static_cast<uint8_t>(index));
+        readyCopy.emplace_back(static_cast<uint8_t>(index));
+        readyList.emplace_back(static_cast<uint8_t>(index));
+    }
+
+    auto start =  chrono::high_resolution_clock::now();
+    for(size_t round = 0; round < 4; round++){
+        while(!ready.empty()){
+            waiting.splice(--waiting.end(), ready, ready.begin());
+        }
+        while(!waiting.empty()){
+            ready.splice(--ready.end(), waiting, waiting.begin());
+        }
+    }
+    auto end = chrono::high_resolution_clock::now();
+    auto timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<"SharedIndexList_splice_handoff "<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    start =  chrono::high_resolution_clock::now();
+    for(size_t round = 0; round < 4; round++){
+        while(!readyCopy.empty()){
+            waitingCopy.emplace_back(readyCopy.front());
+            readyCopy.pop_front();
+        }
+        while(!waitingCopy.empty()){
+            readyCopy.emplace_back(waitingCopy.front());
+            waitingCopy.pop_front();
+        }
+    }
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<"IndexList_copy_handoff "<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    start =  chrono::high_resolution_clock::now();
+    for(size_t round = 0; round < 4; round++){
+        while(!readyList.empty()){
+            waitingList.splice(waitingList.end(), readyList, readyList.begin());
+        }
+        while(!waitingList.empty()){
+            readyList.splice(readyList.end(), waitingList, waitingList.begin());
+        }
+    }
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<"LinkedList_splice_handoff "<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    // two sorted halves merged back into one
+    ready.clear();
+    readyList.clear();
+    for(size_t index = 0; index < count; index++){
+        auto& target        = (index % 2) ? ready : waiting;
+        auto& targetList    = (index % 2) ? readyList : waitingList;
+        target.emplace_back(static_cast<uint8_t>(index * 256 / count));
+        targetList.emplace_back(static_cast<uint8_t>(index * 256 / count));
+    }
+
+    start =  chrono::high_resolution_clock::now();
+    ready.merge(waiting, byKey);
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<"SharedIndexList_merge ("<<ready.size()<<")"<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+
+    start =  chrono::high_resolution_clock::now();
+    readyList.merge(waitingList, byKey);
+    end = chrono::high_resolution_clock::now();
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
+    std::cout<<"LinkedList_merge ("<<readyList.size()<<")"<<std::endl;
+    std::cout<<"Time difference: "<<timeDiff<<" us\n";
+}
+
 int main(){
     
     IndexList<A> indexList;
@@ -111,6 +1258,8 @@ int main(){
     }
     end = chrono::high_resolution_clock::now();
 
+    timeDiff = chrono::duration_cast<chrono::microseconds>(end - start).count();
+
     std::cout<<"IndexList_range_loop "<<std::endl;
     std::cout<<"Time difference: "<<timeDiff<<" us\n";
     
@@ -140,6 +1289,106 @@ int main(){
     std::cout<<"LinkedList_range_loop "<<std::endl;
     std::cout<<"Time difference: "<<timeDiff<<" us\n";
 
+    std::cout<<"\n\n";
+
+    layoutTest<IndexList<A>>("IndexList");
+    layoutTest<IndexList<A, SplitIndexLayout>>("SplitIndexList");
+    layoutTest<IndexList<A, SplitIndexLayout, uint32_t>>("SplitIndexList32");
+    layoutTest<IndexList<A, SegmentedIndexLayout<>>>("SegmentedIndexList");
+
+    std::cout<<"\n\n";
+
+    reorderTest<IndexList<A>>("IndexList");
+    reorderTest<IndexList<A, SplitIndexLayout>>("SplitIndexList");
+
+    std::cout<<"\n\n";
+
+    snapshotTest<IndexList<A>>("IndexList");
+    snapshotTest<IndexList<A, SplitIndexLayout>>("SplitIndexList");
+
+    std::cout<<"\n\n";
+
+    statsTest<IndexList<A>>("IndexList", 0);
+    statsTest<IndexList<A>>("IndexListAutoCompact", 0.5);
+
+    std::cout<<"\n\n";
+
+    allocatorTest();
+
+    std::cout<<"\n\n";
+
+    clearTest<IndexList<A>>("IndexList");
+    clearTest<IndexList<A, SplitIndexLayout>>("SplitIndexList");
+    clearTest<std::list<A>>("LinkedList");
+
+    std::cout<<"\n\n";
+
+    prefetchTest<IndexList<A>>("IndexList");
+    prefetchTest<IndexList<A, SplitIndexLayout>>("SplitIndexList");
+
+    std::cout<<"\n\n";
+
+    constReadTest<IndexList<A>>("IndexList", 4);
+    constReadTest<IndexList<A, SplitIndexLayout>>("SplitIndexList", 4);
+
+    std::cout<<"\n\n";
+
+    sortTest<IndexList<A>>("IndexList");
+    sortTest<IndexList<A, SplitIndexLayout>>("SplitIndexList");
+    sortTest<std::list<A>>("LinkedList");
+    sortTest<IndexList<int>>("IndexListInt");
+    sortTest<std::list<int>>("LinkedListInt");
+
+    std::cout<<"\n\n";
+
+    positionTest<IndexList<A>>("IndexList");
+    positionTest<IndexList<A, SplitIndexLayout>>("SplitIndexList");
+
+    std::cout<<"\n\n";
+
+    bulkTest<IndexList<A>>("IndexList");
+    bulkTest<IndexList<A, SplitIndexLayout>>("SplitIndexList");
+    bulkTest<IndexList<A, SegmentedIndexLayout<>>>("SegmentedIndexList");
+
+    std::cout<<"\n\n";
+
+    removeIfTest<IndexList<A>>("IndexList");
+    removeIfTest<IndexList<A, SplitIndexLayout>>("SplitIndexList");
+    removeIfTest<std::list<A>>("LinkedList");
+
+    std::cout<<"\n\n";
+
+    liveScanTest<IndexList<A>>("IndexList");
+    liveScanTest<IndexList<A, SplitIndexLayout>>("SplitIndexList");
+
+    std::cout<<"\n\n";
+
+    forwardListTest<IndexForwardList<A>>("IndexForwardList");
+    forwardListTest<IndexForwardList<A, uint32_t>>("IndexForwardList32");
+    forwardListTest<std::forward_list<A>>("ForwardList");
+
+    std::cout<<"\n\n";
+
+    sharedSpliceTest();
+
+    std::cout<<"\n\n";
+
+    unrolledTest<UnrolledIndexList<int>>("UnrolledIndexList");
+    unrolledTest<UnrolledIndexList<int, 32>>("UnrolledIndexList32");
+    unrolledTest<IndexList<int>>("IndexList");
+    unrolledTest<std::list<int>>("LinkedList");
+
+    std::cout<<"\n\n";
+
+    parallelTest<IndexList<A>>("IndexList");
+    parallelTest<IndexList<A, SplitIndexLayout>>("SplitIndexList");
+
+    std::cout<<"\n\n";
+
+    for(size_t threadCount = 1; threadCount <= 32; threadCount *= 2){
+        concurrentAllocTest(threadCount);
+    }
+
     #ifdef ENABLE
   //  printList(list);
     
@@ -0,0 +1,410 @@
+#ifndef UNROLLEDINDEXLIST_H
+#define UNROLLEDINDEXLIST_H
+
+#include "indexlist.h"
+
+// Element storage of an IndexBlock, the first count values are constructed.
+// Blocks of trivially copyable types stay trivially copyable so the block
+// pool can move them with memcpy.
+template<class T, size_t Capacity, bool isTrivial = isIndexTriviallyRelocatable<T>>
+struct IndexBlockStorage{
+    IndexBlockStorage(){}
+
+    union{
+        T       _values[Capacity];
+    };
+    size_t      _count = 0;
+};
+
+template<class T, size_t Capacity>
+struct IndexBlockStorage<T, Capacity, false>{
+    IndexBlockStorage(){}
+    IndexBlockStorage(const IndexBlockStorage& other){
+        for(; _count < other._count; ++_count){
+            new (&_values[_count]) T(other._values[_count]);
+        }
+    }
+    // noexcept when T moves without throwing, the block pool moves blocks
+    // instead of copying them when it grows then
+    IndexBlockStorage(IndexBlockStorage&& other) noexcept(std::is_nothrow_move_constructible_v<T>){
+        for(; _count < other._count; ++_count){
+            new (&_values[_count]) T(std::move(other._values[_count]));
+        }
+    }
+    IndexBlockStorage& operator = (const IndexBlockStorage& other){
+        if(this != &other){
+            clear();
+            for(; _count < other._count; ++_count){
+                new (&_values[_count]) T(other._values[_count]);
+            }
+        }
+        return *this;
+    }
+    IndexBlockStorage& operator = (IndexBlockStorage&& other) noexcept(std::is_nothrow_move_constructible_v<T>){
+        if(this != &other){
+            clear();
+            for(; _count < other._count; ++_count){
+                new (&_values[_count]) T(std::move(other._values[_count]));
+            }
+        }
+        return *this;
+    }
+    ~IndexBlockStorage(){
+        clear();
+    }
+
+    void clear(){
+        for(; _count > 0; --_count){
+            _values[_count - 1].~T();
+        }
+    }
+
+    union{
+        T       _values[Capacity];
+    };
+    size_t      _count = 0;
+};
+
+// Fixed array of up to Capacity elements kept packed at the front, the
+// payload of one UnrolledIndexList node.
+template<class T, size_t Capacity>
+class IndexBlock : public IndexBlockStorage<T, Capacity>{
+    using IndexBlockStorage<T, Capacity>::_values;
+    using IndexBlockStorage<T, Capacity>::_count;
+
+    public:
+
+    size_t size() const {return _count;}
+    bool full() const {return (_count == Capacity);}
+
+    T& operator [] (size_t position){return _values[position];}
+    const T& operator [] (size_t position) const {return _values[position];}
+
+    // constructs an element at position and shifts the ones behind it up,
+    // the block must not be full
+    template <class... Args>
+    void emplace(size_t position, Args&&... args){
+        if(position == _count){
+            new (&_values[_count]) T(std::forward<Args>(args)...);
+        }
+        else if constexpr(isIndexTriviallyRelocatable<T>){
+            T value(std::forward<Args>(args)...);
+            memmove(static_cast<void*>(&_values[position + 1]), &_values[position], (_count - position) * sizeof(T));
+            new (&_values[position]) T(value);
+        }
+        else{
+            T value(std::forward<Args>(args)...);
+            new (&_values[_count]) T(std::move(_values[_count - 1]));
+            std::move_backward(&_values[position], &_values[_count - 1], &_values[_count]);
+            _values[position] = std::move(value);
+        }
+        ++_count;
+    }
+
+    // destroys the element at position and shifts the ones behind it down
+    void erase(size_t position){
+        if constexpr(isIndexTriviallyRelocatable<T>){
+            memmove(static_cast<void*>(&_values[position]), &_values[position + 1], (_count - position - 1) * sizeof(T));
+        }
+        else{
+            std::move(&_values[position + 1], &_values[_count], &_values[position]);
+            _values[_count - 1].~T();
+        }
+        --_count;
+    }
+
+    // moves the elements from position on to the back of other
+    void moveTail(size_t position, IndexBlock& other){
+        if constexpr(isIndexTriviallyRelocatable<T>){
+            memcpy(static_cast<void*>(&other._values[other._count]), &_values[position], (_count - position) * sizeof(T));
+            other._count    += _count - position;
+            _count          = position;
+        }
+        else{
+            for(size_t index = position; index < _count; ++index){
+                new (&other._values[other._count]) T(std::move(_values[index]));
+                ++other._count;
+            }
+            while(_count > position){
+                _values[--_count].~T();
+            }
+        }
+    }
+};
+
+template <class List>
+class UnrolledIndexIterator{
+    public:
+    using difference_type   = std::ptrdiff_t;
+    using value_type        = typename List::value_type;
+    using pointer           = value_type*;
+    using reference         = value_type&;
+    using iterator_category = std::bidirectional_iterator_tag;
+    using index_type        = typename List::index_type;
+
+    constexpr UnrolledIndexIterator() : _list(nullptr), _block(0), _offset(0){}
+
+    bool operator != (const UnrolledIndexIterator& it) const{
+        return !(*this == it);
+    }
+
+    bool operator == (const UnrolledIndexIterator& it) const{
+        return (_block == it._block && _offset == it._offset);
+    }
+
+    // end() has no block, it steps on to the first one like operator--()
+    // steps from there back to end()
+    UnrolledIndexIterator& operator++(){
+        if(_block == List::endIndex || ++_offset == block().size()){
+            _block  = _list->_blocks._pool.link(_block).getNext();
+            _offset = 0;
+        }
+        return *this;
+    }
+    UnrolledIndexIterator& operator--(){
+        if(_offset == 0){
+            _block  = _list->_blocks._pool.link(_block).getPrevious();
+            _offset = (_block == List::endIndex) ? 0 : block().size() - 1;
+        }
+        else{
+            --_offset;
+        }
+        return *this;
+    }
+
+    UnrolledIndexIterator operator--(int){
+        auto it = *this;
+        --(*this);
+        return it;
+    }
+
+    UnrolledIndexIterator operator++(int){
+        auto it = *this;
+        ++(*this);
+        return it;
+    }
+
+    // skips whole blocks, O(advance / Capacity)
+    UnrolledIndexIterator operator+(size_t advance) const{
+        auto it = *this;
+        while(advance > 0 && it._block != List::endIndex){
+            const size_t left = it.block().size() - it._offset;
+            if(advance < left){
+                it._offset += advance;
+                return it;
+            }
+            advance     -= left;
+            it._block   = it._list->_blocks._pool.link(it._block).getNext();
+            it._offset  = 0;
+        }
+        return it;
+    }
+
+    UnrolledIndexIterator operator-(size_t advance) const{
+        auto it = *this;
+        while(advance > 0){
+            if(it._offset >= advance){
+                it._offset -= advance;
+                return it;
+            }
+            advance     -= it._offset + 1;
+            it._offset  = 0;
+            --it;
+        }
+        return it;
+    }
+
+    reference operator*(void){
+        return block()[_offset];
+    }
+    pointer operator->(void){
+        return &block()[_offset];
+    }
+
+    index_type getBlockIndex() const {return _block;}
+    size_t getOffset() const {return _offset;}
+
+    private:
+    List* _list;
+    index_type _block;
+    size_t _offset;
+
+    constexpr UnrolledIndexIterator(List* list, index_type block, size_t offset) : _list(list), _block(block), _offset(offset){}
+
+    typename List::block_type& block() const{
+        return _list->_blocks._pool.data(_block);
+    }
+
+    friend List;
+};
+
+// Unrolled linked list on top of IndexList, every node holds up to Capacity
+// elements so iteration is mostly linear and there is one link pair per
+// block instead of per element. Inserting into a full block splits it,
+// erasing merges a block with its successor once both together fit into
+// half a block. Iterators into a block are invalidated by inserts and
+// erases in that block.
+template<class T, size_t Capacity = 16, class Layout = InterleavedIndexLayout, class Index = index_t>
+class UnrolledIndexList{
+    static_assert(Capacity >= 2, "a block has to hold at least two elements");
+
+    public:
+    using value_type    = T;
+    using index_type    = Index;
+    using block_type    = IndexBlock<T, Capacity>;
+    using block_list    = IndexList<block_type, Layout, Index>;
+    using iterator      = UnrolledIndexIterator<UnrolledIndexList>;
+
+    iterator begin(){
+        return iterator(this, _blocks._pool.link(endIndex).getNext(), 0);
+    }
+    iterator end(){
+        return iterator(this, endIndex, 0);
+    }
+
+    T& front(){
+        return _blocks.front()[0];
+    }
+    T& back(){
+        return _blocks.back()[_blocks.back().size() - 1];
+    }
+
+    // inserts after it like IndexList::insert, end() inserts at the front
+    template <class... Args>
+    iterator emplace(iterator it, Args&&... args){
+        if(it._block == endIndex){
+            return emplaceAt(_blocks._pool.link(endIndex).getNext(), 0, std::forward<Args>(args)...);
+        }
+        return emplaceAt(it._block, it._offset + 1, std::forward<Args>(args)...);
+    }
+
+    template <class... Args>
+    iterator emplace_front(Args&&... args){
+        return emplaceAt(_blocks._pool.link(endIndex).getNext(), 0, std::forward<Args>(args)...);
+    }
+
+    template <class... Args>
+    iterator emplace_back(Args&&... args){
+        const Index block = _blocks._pool.link(endIndex).getPrevious();
+        return emplaceAt(block, (block == endIndex) ? 0 : _blocks._pool.data(block).size(), std::forward<Args>(args)...);
+    }
+
+    iterator insert(iterator it, const T& data){
+        return emplace(it, data);
+    }
+    iterator insert(iterator it, T&& data){
+        return emplace(it, std::move(data));
+    }
+    iterator push_front(const T& data){
+        return emplace_front(data);
+    }
+    iterator push_front(T&& data){
+        return emplace_front(std::move(data));
+    }
+    iterator push_back(const T& data){
+        return emplace_back(data);
+    }
+    iterator push_back(T&& data){
+        return emplace_back(std::move(data));
+    }
+
+    // returns iterator to the element behind the erased one
+    iterator erase(iterator it){
+        const Index block       = it._block;
+        const size_t position   = it._offset;
+        block_type& target      = _blocks._pool.data(block);
+
+        target.erase(position);
+        --_size;
+
+        const Index next = _blocks._pool.link(block).getNext();
+        if(target.size() == 0){
+            _blocks.erase(_blocks.iteratorAt(block));
+            return iterator(this, next, 0);
+        }
+        if(next != endIndex && target.size() + _blocks._pool.data(next).size() <= Capacity / 2){
+            _blocks._pool.data(next).moveTail(0, target);
+            _blocks.erase(_blocks.iteratorAt(next));
+        }
+        if(position < target.size()){
+            return iterator(this, block, position);
+        }
+        return iterator(this, _blocks._pool.link(block).getNext(), 0);
+    }
+
+    void pop_front(){
+        erase(begin());
+    }
+    void pop_back(){
+        erase(--end());
+    }
+
+    void clear(){
+        _blocks.clear();
+        _size = 0;
+    }
+
+    // lays the blocks out in list order, see IndexList::reorder()
+    void reorder(){
+        _blocks.reorder();
+    }
+    void shrink_to_fit(){
+        _blocks.shrink_to_fit();
+    }
+
+    size_t size() const{
+        return _size;
+    }
+    bool empty() const{
+        return (_size == 0);
+    }
+    size_t blockCount() const{
+        return _blocks.size();
+    }
+
+    constexpr static Index endIndex = block_list::endIndex;
+
+    private:
+    block_list  _blocks;
+    size_t      _size = 0;
+
+    // constructs an element at position of block, a full block gets a new
+    // neighbour for appends at either end and is split otherwise
+    template <class... Args>
+    iterator emplaceAt(Index block, size_t position, Args&&... args){
+        if(block != endIndex && !_blocks._pool.data(block).full()){
+            _blocks._pool.data(block).emplace(position, std::forward<Args>(args)...);
+            ++_size;
+            return iterator(this, block, position);
+        }
+
+        // args may refer to an element, adding a block can move the pool and
+        // a split moves elements, so the new one is built first
+        T value(std::forward<Args>(args)...);
+        if(block == endIndex){
+            block = _blocks.emplace_back().getCurrentIndex();
+        }
+        else if(position == Capacity){
+            block       = _blocks.emplace(block).getCurrentIndex();
+            position    = 0;
+        }
+        else if(position == 0){
+            block       = _blocks.emplace(_blocks._pool.link(block).getPrevious()).getCurrentIndex();
+        }
+        else{
+            const Index half = _blocks.emplace(block).getCurrentIndex();
+            _blocks._pool.data(block).moveTail(Capacity / 2, _blocks._pool.data(half));
+            if(position > Capacity / 2){
+                block       = half;
+                position    -= Capacity / 2;
+            }
+        }
+        _blocks._pool.data(block).emplace(position, std::move(value));
+        ++_size;
+        return iterator(this, block, position);
+    }
+
+    friend iterator;
+};
+
+#endif // UNROLLEDINDEXLIST_H